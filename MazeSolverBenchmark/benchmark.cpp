@@ -0,0 +1,477 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../MazeSolverSimulation/maze/mazesolver.h"
+#include "../MazeSolverTests/simulatedmaze.h"
+
+/*
+	Usage: MazeSolverBenchmark [--output results.csv] [--json] [--baseline baseline.csv] [--tolerance 0.10] [--repetitions 5] [--min-time 10]
+
+	The size of the maze is fixed at compile time, define MAZESOLVER_WIDTH and MAZESOLVER_HEIGHT
+	to measure the planners and the solutions on another size, the project builds one executable for every size
+	with the BuildSizes target. The rows that depend on the size are labelled with it.
+	The iterations of a row are doubled until a sample takes at least the minimum time in milliseconds.
+	With a baseline every result slower than the baseline by more than the tolerance is reported
+	and the benchmark exits with a non-zero code.
+*/
+
+struct Result
+{
+	std::string Name;
+	long long Iterations;
+	double Nanoseconds; // The median time of one iteration
+};
+
+const int Width = MazeSolver::Solver::Width;
+const int Height = MazeSolver::Solver::Height;
+
+SimulatedMaze maze;
+
+MazeSolver::Solver* solver = nullptr;
+
+// Keeps the results from being optimized away
+volatile long long sink = 0;
+
+int repetitions = 5;
+double minimumSampleTime = 10e6; // In nanoseconds
+std::vector<Result> results;
+
+bool Scan(MazeSolver::Direction direction)
+{
+	int point = solver->CurrentPoint;
+	return !maze.IsBlocked(point, maze.GetAdjacent(point, direction));
+}
+
+unsigned int RangeScan(MazeSolver::Direction direction)
+{
+	// The open edges in a row up to a wall or the border
+	unsigned int range = 0;
+	int point = solver->CurrentPoint;
+	while (true)
+	{
+		int nextPoint = MazeSolver::Topology::GetAdjacent(direction, point);
+		if (nextPoint == -1 || maze.IsBlocked(point, nextPoint))
+			return range;
+
+		range++;
+		point = nextPoint;
+	}
+}
+
+void Move(MazeSolver::Direction)
+{
+}
+
+template<typename Function>
+void Measure(const std::string& name, long long iterations, Function function)
+{
+	// The shorter samples are mostly the noise of the clock, the doubling also warms up the caches
+	while (true)
+	{
+		auto start = std::chrono::steady_clock::now();
+		function(iterations);
+		auto end = std::chrono::steady_clock::now();
+
+		if (std::chrono::duration<double, std::nano>(end - start).count() >= minimumSampleTime)
+			break;
+
+		iterations *= 2;
+	}
+
+	std::vector<double> samples;
+	for (int i = 0; i < repetitions; i++)
+	{
+		auto start = std::chrono::steady_clock::now();
+		function(iterations);
+		auto end = std::chrono::steady_clock::now();
+
+		samples.push_back(std::chrono::duration<double, std::nano>(end - start).count() / iterations);
+	}
+
+	std::sort(samples.begin(), samples.end());
+	results.push_back({ name, iterations, samples[samples.size() / 2] });
+
+	std::cerr << name << ": " << samples[samples.size() / 2] << " ns" << std::endl;
+}
+
+template<typename Container>
+void MeasureContainer(const std::string& name, long long iterations)
+{
+	Measure(name + "/push_pop", iterations, [](long long iterations)
+	{
+		Container container;
+		for (long long i = 0; i < iterations; i++)
+		{
+			for (int j = 0; j < 16; j++)
+				container.Push(j);
+			for (int j = 0; j < 16; j++)
+				sink = sink + container.Pop();
+		}
+	});
+}
+
+template<typename Container>
+void MeasureQueue(const std::string& name, long long iterations, int length)
+{
+	Measure(name + "/push_dequeue/" + std::to_string(length), iterations, [length](long long iterations)
+	{
+		Container container;
+		for (long long i = 0; i < iterations; i++)
+		{
+			for (int j = 0; j < length; j++)
+				container.Push(j);
+			for (int j = 0; j < length; j++)
+				sink = sink + container.Dequeue();
+		}
+	});
+}
+
+void MeasureContainers()
+{
+	MeasureContainer<MazeSolver::List<int>>("list", 100000);
+	MeasureContainer<MazeSolver::StaticList<int, 16>>("static_list", 100000);
+
+	MeasureQueue<MazeSolver::List<int>>("list", 10000, 16);
+	MeasureQueue<MazeSolver::List<int>>("list", 100, 1024);
+	MeasureQueue<MazeSolver::StaticList<int, 1024>>("static_list", 10000, 16);
+	MeasureQueue<MazeSolver::StaticList<int, 1024>>("static_list", 100, 1024);
+
+	Measure("stack/push_pop", 100000, [](long long iterations)
+	{
+		MazeSolver::Stack<int> stack;
+		for (long long i = 0; i < iterations; i++)
+		{
+			for (int j = 0; j < 16; j++)
+				stack.Push(j);
+			for (int j = 0; j < 16; j++)
+				sink = sink + stack.Pop();
+		}
+	});
+
+	Measure("queue/push_pop", 100000, [](long long iterations)
+	{
+		MazeSolver::Queue<int> queue;
+		for (long long i = 0; i < iterations; i++)
+		{
+			for (int j = 0; j < 16; j++)
+				queue.Push(j);
+			for (int j = 0; j < 16; j++)
+				sink = sink + queue.Pop();
+		}
+	});
+}
+
+void MeasurePlanners()
+{
+	const char* const planners[]
+	{
+		"bfs",
+		"hierarchical",
+		"parallel"
+	};
+
+	std::string size = std::to_string(Width) + "x" + std::to_string(Height);
+	long long iterations = 200000 / (Width * Height) + 1;
+
+	for (int density : { 0, 20, 40 })
+	{
+		for (int planner = 0; planner < 3; planner++)
+		{
+#if !defined MAZESOLVER_HIERARCHICAL_PLANNER
+			if ((MazeSolver::Planner)planner == MazeSolver::Planner::Hierarchical)
+				continue;
+#endif
+#if !defined MAZESOLVER_PARALLEL_PLANNER
+			if ((MazeSolver::Planner)planner == MazeSolver::Planner::Parallel)
+				continue;
+#endif
+
+			// Every wall of the maze is known to the planner
+			maze.Generate(density, density);
+
+			MazeSolver::Solver* plannerSolver = new MazeSolver::Solver(Scan, Move);
+			plannerSolver->SetPlanner((MazeSolver::Planner)planner);
+
+			MazeSolver::ObstacleList* obstacles = new MazeSolver::ObstacleList();
+			for (int point = 0; point < Width * Height; point++)
+			{
+				if (maze.WallUp[point])
+					plannerSolver->Memorize(*obstacles, MazeSolver::Obstacle(point, point + Width));
+				if (maze.WallRight[point])
+					plannerSolver->Memorize(*obstacles, MazeSolver::Obstacle(point, point + 1));
+			}
+
+			MazeSolver::Path* path = new MazeSolver::Path();
+			Measure(std::string("shortest_path/") + planners[planner] + "/" + size + "/d" + std::to_string(density), iterations, [&](long long iterations)
+			{
+				for (long long i = 0; i < iterations; i++)
+					sink = sink + plannerSolver->Plan(0, *obstacles, *path);
+			});
+
+			delete path;
+			delete obstacles;
+			delete plannerSolver;
+		}
+	}
+}
+
+void MeasureDistanceField()
+{
+	std::string size = std::to_string(Width) + "x" + std::to_string(Height);
+
+	for (int density : { 20, 40 })
+	{
+		maze.Generate(density, density);
+
+		// One iteration adds every wall of the maze to the field, one at a time
+		MazeSolver::DistanceField* field = new MazeSolver::DistanceField();
+		Measure("distance_field/add_walls/" + size + "/d" + std::to_string(density), 1, [&](long long iterations)
+		{
+			for (long long i = 0; i < iterations; i++)
+			{
+				field->Clear();
+				field->AddGoal(Width * Height - 1);
+
+				for (int point = 0; point < Width * Height; point++)
+				{
+					if (maze.WallUp[point])
+						field->AddWall(point, point + Width);
+					if (maze.WallRight[point])
+						field->AddWall(point, point + 1);
+				}
+
+				sink = sink + field->DistanceToGoal(0);
+			}
+		});
+
+		delete field;
+	}
+}
+
+void MeasureBatchPlanner()
+{
+	std::string size = std::to_string(Width) + "x" + std::to_string(Height);
+	std::string lanes = std::to_string(MazeSolver::BatchPlanner::Lanes);
+
+	for (int density : { 20, 40 })
+	{
+		// Every lane gets a maze of its own
+		MazeSolver::BatchPlanner* planner = new MazeSolver::BatchPlanner();
+		for (unsigned int lane = 0; lane < MazeSolver::BatchPlanner::Lanes; lane++)
+		{
+			maze.Generate(lane, density);
+
+			for (int point = 0; point < Width * Height; point++)
+			{
+				if (maze.WallUp[point])
+					planner->AddWall(lane, point, point + Width);
+				if (maze.WallRight[point])
+					planner->AddWall(lane, point, point + 1);
+			}
+		}
+
+		// One iteration searches all of the lanes
+		Measure("batch_planner/search/" + lanes + "_lanes/" + size + "/d" + std::to_string(density), 1000, [&](long long iterations)
+		{
+			for (long long i = 0; i < iterations; i++)
+				sink = sink + planner->Search(0, Width * Height - 1);
+		});
+
+		delete planner;
+	}
+}
+
+void MeasureSolutions()
+{
+	const char* const solutions[]
+	{
+		"periodic_correction",
+		"algorithmic_runner",
+		"frontier_exploration",
+		"best_first_runner",
+		"wall_follower"
+	};
+
+	std::string size = std::to_string(Width) + "x" + std::to_string(Height);
+	const int mazes = 20;
+
+	for (int density : { 10, 30 })
+	{
+		for (int solution = 0; solution < 5; solution++)
+		{
+			// One iteration solves one of the mazes, the solver is built once and solves all of them
+			solver = new MazeSolver::Solver(Scan, Move);
+			Measure(std::string("solve/") + solutions[solution] + "/" + size + "/d" + std::to_string(density), mazes, [&](long long iterations)
+			{
+				for (long long i = 0; i < iterations; i++)
+				{
+					maze.Generate((unsigned int)(i % mazes), density);
+
+					solver->CurrentPoint = solver->StartPoint;
+					sink = sink + solver->Solve((MazeSolver::Solution)solution);
+				}
+			});
+
+			delete solver;
+			solver = nullptr;
+		}
+
+		// The same mazes are solved again and again, the searches repeat with the same walls
+		MazeSolver::PlanCache* planCache = new MazeSolver::PlanCache();
+		solver = new MazeSolver::Solver(Scan, Move);
+		solver->SetPlanCache(planCache);
+		Measure(std::string("solve/periodic_correction_cached/") + size + "/d" + std::to_string(density), mazes, [&](long long iterations)
+		{
+			for (long long i = 0; i < iterations; i++)
+			{
+				maze.Generate((unsigned int)(i % mazes), density);
+
+				solver->CurrentPoint = solver->StartPoint;
+				sink = sink + solver->Solve(MazeSolver::Solution::PeriodicCorrection);
+			}
+		});
+
+		delete solver;
+		delete planCache;
+
+		// A single scan finds every edge along a ray
+		solver = new MazeSolver::Solver(Scan, Move);
+		solver->SetRangeScanFunction(RangeScan);
+		Measure(std::string("solve/periodic_correction_range/") + size + "/d" + std::to_string(density), mazes, [&](long long iterations)
+		{
+			for (long long i = 0; i < iterations; i++)
+			{
+				maze.Generate((unsigned int)(i % mazes), density);
+
+				solver->CurrentPoint = solver->StartPoint;
+				sink = sink + solver->Solve(MazeSolver::Solution::PeriodicCorrection);
+			}
+		});
+
+		delete solver;
+		solver = nullptr;
+	}
+}
+
+void WriteResults(std::ostream& stream, bool json)
+{
+	if (json)
+	{
+		stream << "[" << std::endl;
+		for (size_t i = 0; i < results.size(); i++)
+		{
+			stream << "  { \"name\": \"" << results[i].Name << "\", \"iterations\": " << results[i].Iterations
+				<< ", \"ns_per_op\": " << results[i].Nanoseconds << " }" << (i + 1 < results.size() ? "," : "") << std::endl;
+		}
+		stream << "]" << std::endl;
+
+		return;
+	}
+
+	stream << "name,iterations,ns_per_op" << std::endl;
+	for (Result& result : results)
+		stream << result.Name << "," << result.Iterations << "," << result.Nanoseconds << std::endl;
+}
+
+int CompareWithBaseline(const char* path, double tolerance)
+{
+	std::ifstream file(path);
+	if (!file)
+	{
+		std::cerr << "Cannot open the baseline " << path << std::endl;
+		return 2;
+	}
+
+	// The baseline is a CSV written by a previous run
+	std::map<std::string, double> baseline;
+	std::string line;
+	std::getline(file, line);
+	while (std::getline(file, line))
+	{
+		std::stringstream stream(line);
+		std::string name, iterations, nanoseconds;
+		if (std::getline(stream, name, ',') && std::getline(stream, iterations, ',') && std::getline(stream, nanoseconds, ','))
+			baseline[name] = std::atof(nanoseconds.c_str());
+	}
+
+	int regressions = 0;
+	for (Result& result : results)
+	{
+		auto found = baseline.find(result.Name);
+		if (found == baseline.end() || found->second <= 0)
+			continue;
+
+		double change = result.Nanoseconds / found->second - 1;
+		if (change > tolerance)
+		{
+			std::cerr << "Regression: " << result.Name << " " << found->second << " ns -> " << result.Nanoseconds
+				<< " ns (+" << (int)(change * 100) << "%)" << std::endl;
+			regressions++;
+		}
+	}
+
+	std::cerr << regressions << " regression(s) against " << path << std::endl;
+
+	return regressions == 0 ? 0 : 1;
+}
+
+int main(int argc, char* argv[])
+{
+	const char* output = nullptr;
+	const char* baseline = nullptr;
+	double tolerance = 0.10;
+	bool json = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::strcmp(argv[i], "--output") == 0 && i + 1 < argc)
+			output = argv[++i];
+		else if (std::strcmp(argv[i], "--baseline") == 0 && i + 1 < argc)
+			baseline = argv[++i];
+		else if (std::strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc)
+			tolerance = std::atof(argv[++i]);
+		else if (std::strcmp(argv[i], "--repetitions") == 0 && i + 1 < argc)
+			repetitions = std::atoi(argv[++i]);
+		else if (std::strcmp(argv[i], "--min-time") == 0 && i + 1 < argc)
+			minimumSampleTime = std::atof(argv[++i]) * 1e6;
+		else if (std::strcmp(argv[i], "--json") == 0)
+			json = true;
+		else
+		{
+			std::cerr << "Unknown argument: " << argv[i] << std::endl;
+			return 2;
+		}
+	}
+
+	if (repetitions < 1)
+		repetitions = 1;
+
+	MeasureContainers();
+	MeasurePlanners();
+	MeasureDistanceField();
+	MeasureBatchPlanner();
+	MeasureSolutions();
+
+	if (output != nullptr)
+	{
+		std::ofstream file(output);
+		WriteResults(file, json);
+	}
+	else
+	{
+		WriteResults(std::cout, json);
+	}
+
+	if (baseline != nullptr)
+		return CompareWithBaseline(baseline, tolerance);
+
+	return 0;
+}
\ No newline at end of file
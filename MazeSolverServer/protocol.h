@@ -0,0 +1,69 @@
+#pragma once
+
+/*
+	The robot and the server exchange frames of 4 bytes: the type, an argument and a little-endian 16-bit count.
+
+	Robot -> server:
+		Hello       argument: the solution, starts the session
+		ScanResult  argument: 1 if there is a path in the scanned direction, 0 otherwise
+		MoveDone    the robot has finished the last move
+
+	Server -> robot:
+		Scan        argument: the direction to scan
+		Move        argument: the direction to move in, count: the number of points to move straight
+		Done        argument: the status of the solve, the session ends
+*/
+
+namespace Protocol
+{
+
+	enum class MessageType : unsigned char
+	{
+		Invalid,
+		Hello,
+		ScanResult,
+		MoveDone,
+		Scan,
+		Move,
+		Done
+	};
+
+	// The size of every frame in bytes
+	const unsigned int FrameSize = 4;
+
+	struct Frame
+	{
+		MessageType Type = MessageType::Invalid;
+		unsigned char Argument = 0;
+		unsigned short Count = 0;
+	};
+
+	/// <summary>
+	/// Writes a frame into its bytes.
+	/// </summary>
+	/// <param name="frame">The frame to write.</param>
+	/// <param name="bytes">A place for the frame size of bytes.</param>
+	inline void Encode(const Frame& frame, unsigned char* bytes)
+	{
+		bytes[0] = (unsigned char)frame.Type;
+		bytes[1] = frame.Argument;
+		bytes[2] = (unsigned char)(frame.Count & 0xFF);
+		bytes[3] = (unsigned char)(frame.Count >> 8);
+	}
+
+	/// <summary>
+	/// Reads a frame from its bytes.
+	/// </summary>
+	/// <param name="bytes">The frame size of bytes.</param>
+	/// <returns>The frame.</returns>
+	inline Frame Decode(const unsigned char* bytes)
+	{
+		Frame frame;
+		frame.Type = (MessageType)bytes[0];
+		frame.Argument = bytes[1];
+		frame.Count = (unsigned short)(bytes[2] | (bytes[3] << 8));
+
+		return frame;
+	}
+
+}
\ No newline at end of file
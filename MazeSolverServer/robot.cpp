@@ -0,0 +1,358 @@
+/*
+	Simulates the robots of the server, every connection solves its own random maze.
+
+	MazeSolverRobot [--unix path | --port number] [--sessions count] [--total count]
+	                [--density percent] [--solution periodic|runner|frontier|best-first|wall-follower] [--seed number]
+
+	The robots answer the scans from the walls of their maze, follow the moves and check that the moves
+	don't go through the walls and that the server ends the session at the exit exactly when the exit can be reached.
+*/
+
+// Linux only, built with the sources of the solver:
+// g++ -std=c++14 -O2 -o MazeSolverRobot robot.cpp ../MazeSolverSimulation/maze/*.cpp -lpthread
+
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+
+#include <signal.h>
+#include <sys/epoll.h>
+
+#include "../MazeSolverSimulation/maze/mazesolver.h"
+#include "protocol.h"
+#include "socket.h"
+
+using Topology = MazeSolver::Topology;
+
+const int Cells = MAZESOLVER_WIDTH * MAZESOLVER_HEIGHT;
+const int StartPoint = 0;
+const int EndPoint = Cells - 1;
+
+struct Robot
+{
+	int Socket = -1;
+
+	// The walls of the maze, one per edge of the topology
+	bool Walls[Topology::Edges];
+	bool Reachable = false;
+
+	int Point = StartPoint;
+
+	unsigned char Input[Protocol::FrameSize];
+	unsigned int InputSize = 0;
+
+	unsigned int Moves = 0;
+	unsigned int Scans = 0;
+};
+
+int epoll = -1;
+
+const char* unixPath = nullptr;
+int port = 7878;
+
+unsigned int density = 30;
+MazeSolver::Solution solution = MazeSolver::Solution::PeriodicCorrection;
+
+std::mt19937 generator;
+
+unsigned int started = 0;
+unsigned int finished = 0;
+unsigned int solved = 0;
+unsigned int errors = 0;
+unsigned long long moves = 0;
+unsigned long long scans = 0;
+
+bool IsOpen(Robot* robot, int first, int second)
+{
+	return second != -1 && !robot->Walls[Topology::GetEdge(first, second)];
+}
+
+bool SearchExit(Robot* robot)
+{
+	bool visited[Cells] = {};
+	int queue[Cells];
+	unsigned int head = 0;
+	unsigned int tail = 0;
+
+	queue[tail++] = StartPoint;
+	visited[StartPoint] = true;
+
+	while (head != tail)
+	{
+		int point = queue[head++];
+		if (point == EndPoint)
+			return true;
+
+		for (unsigned int i = 0; i < Topology::Directions; i++)
+		{
+			int adjacent = Topology::GetAdjacent(Topology::GetDirection(i), point);
+			if (!IsOpen(robot, point, adjacent) || visited[adjacent])
+				continue;
+
+			visited[adjacent] = true;
+			queue[tail++] = adjacent;
+		}
+	}
+
+	return false;
+}
+
+bool Send(Robot* robot, Protocol::MessageType type, unsigned char argument)
+{
+	Protocol::Frame frame;
+	frame.Type = type;
+	frame.Argument = argument;
+
+	unsigned char bytes[Protocol::FrameSize];
+	Protocol::Encode(frame, bytes);
+
+	// Only one frame is ever in flight, so the socket always has room for it
+	return send(robot->Socket, bytes, sizeof(bytes), MSG_NOSIGNAL) == (ssize_t)sizeof(bytes);
+}
+
+void Disconnect(Robot* robot, bool failed)
+{
+	if (failed)
+		errors++;
+
+	moves += robot->Moves;
+	scans += robot->Scans;
+	finished++;
+
+	epoll_ctl(epoll, EPOLL_CTL_DEL, robot->Socket, nullptr);
+	close(robot->Socket);
+	delete robot;
+}
+
+bool Connect()
+{
+	Robot* robot = new Robot();
+
+	for (unsigned int edge = 0; edge < Topology::Edges; edge++)
+		robot->Walls[edge] = generator() % 100 < density;
+	robot->Reachable = SearchExit(robot);
+
+	robot->Socket = Socket::Open(unixPath, port, false);
+	if (robot->Socket == -1)
+	{
+		delete robot;
+		return false;
+	}
+
+	Socket::SetNonBlocking(robot->Socket);
+
+	epoll_event event;
+	event.events = EPOLLIN | EPOLLRDHUP;
+	event.data.ptr = robot;
+	epoll_ctl(epoll, EPOLL_CTL_ADD, robot->Socket, &event);
+
+	started++;
+	if (!Send(robot, Protocol::MessageType::Hello, (unsigned char)solution))
+		Disconnect(robot, true);
+
+	return true;
+}
+
+// Returns false when the session is over
+bool Handle(Robot* robot, const Protocol::Frame& frame)
+{
+	switch (frame.Type)
+	{
+	case Protocol::MessageType::Scan:
+	{
+		int adjacent = Topology::GetAdjacent((MazeSolver::Direction)frame.Argument, robot->Point);
+		robot->Scans++;
+
+		if (!Send(robot, Protocol::MessageType::ScanResult, IsOpen(robot, robot->Point, adjacent) ? 1 : 0))
+		{
+			Disconnect(robot, true);
+			return false;
+		}
+
+		return true;
+	}
+	case Protocol::MessageType::Move:
+		for (unsigned int i = 0; i < frame.Count; i++)
+		{
+			int adjacent = Topology::GetAdjacent((MazeSolver::Direction)frame.Argument, robot->Point);
+			if (!IsOpen(robot, robot->Point, adjacent))
+			{
+				std::cerr << "The robot was moved into a wall at point " << robot->Point << std::endl;
+				Disconnect(robot, true);
+				return false;
+			}
+
+			robot->Point = adjacent;
+			robot->Moves++;
+		}
+
+		if (!Send(robot, Protocol::MessageType::MoveDone, 0))
+		{
+			Disconnect(robot, true);
+			return false;
+		}
+
+		return true;
+	case Protocol::MessageType::Done:
+	{
+		MazeSolver::SolveStatus status = (MazeSolver::SolveStatus)frame.Argument;
+		bool failed;
+
+		if (status == MazeSolver::SolveStatus::Solved)
+		{
+			failed = !robot->Reachable || robot->Point != EndPoint;
+			if (!failed)
+				solved++;
+		}
+		else if (status == MazeSolver::SolveStatus::GaveUp)
+		{
+			// The wall follower without the Tremaux marks does not tell whether the exit is reachable
+			failed = false;
+		}
+		else
+		{
+			failed = robot->Reachable || status != MazeSolver::SolveStatus::Unreachable;
+		}
+
+		if (failed)
+			std::cerr << "The session ended with status " << (int)status << " at point " << robot->Point << ", the exit is " << (robot->Reachable ? "reachable" : "unreachable") << std::endl;
+
+		Disconnect(robot, failed);
+		return false;
+	}
+	default:
+		std::cerr << "Unexpected frame " << (int)frame.Type << std::endl;
+		Disconnect(robot, true);
+		return false;
+	}
+}
+
+void Receive(Robot* robot)
+{
+	while (true)
+	{
+		ssize_t received = recv(robot->Socket, robot->Input + robot->InputSize, Protocol::FrameSize - robot->InputSize, 0);
+		if (received <= 0)
+		{
+			if (received < 0 && errno == EINTR)
+				continue;
+
+			if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+				return;
+
+			// The server closed the connection without ending the session
+			std::cerr << "The connection was closed before the session ended" << std::endl;
+			Disconnect(robot, true);
+			return;
+		}
+
+		robot->InputSize += (unsigned int)received;
+		if (robot->InputSize != Protocol::FrameSize)
+			continue;
+
+		robot->InputSize = 0;
+		if (!Handle(robot, Protocol::Decode(robot->Input)))
+			return;
+	}
+}
+
+void PrintUsage()
+{
+	std::cerr << "Usage: MazeSolverRobot [--unix path | --port number] [--sessions count] [--total count] "
+		"[--density percent] [--solution periodic|runner|frontier|best-first|wall-follower] [--seed number]" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+	unsigned int concurrent = 64;
+	unsigned int total = 1000;
+	unsigned int seed = 1;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::strcmp(argv[i], "--unix") == 0 && i + 1 < argc)
+			unixPath = argv[++i];
+		else if (std::strcmp(argv[i], "--port") == 0 && i + 1 < argc)
+			port = std::atoi(argv[++i]);
+		else if (std::strcmp(argv[i], "--sessions") == 0 && i + 1 < argc)
+			concurrent = (unsigned int)std::atoi(argv[++i]);
+		else if (std::strcmp(argv[i], "--total") == 0 && i + 1 < argc)
+			total = (unsigned int)std::atoi(argv[++i]);
+		else if (std::strcmp(argv[i], "--density") == 0 && i + 1 < argc)
+			density = (unsigned int)std::atoi(argv[++i]);
+		else if (std::strcmp(argv[i], "--solution") == 0 && i + 1 < argc)
+		{
+			i++;
+			if (std::strcmp(argv[i], "runner") == 0)
+				solution = MazeSolver::Solution::AlgorithmicRunner;
+			else if (std::strcmp(argv[i], "frontier") == 0)
+				solution = MazeSolver::Solution::FrontierExploration;
+			else if (std::strcmp(argv[i], "best-first") == 0)
+				solution = MazeSolver::Solution::BestFirstRunner;
+			else if (std::strcmp(argv[i], "wall-follower") == 0)
+				solution = MazeSolver::Solution::WallFollower;
+			else if (std::strcmp(argv[i], "periodic") == 0)
+				solution = MazeSolver::Solution::PeriodicCorrection;
+			else
+			{
+				PrintUsage();
+				return 1;
+			}
+		}
+		else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+			seed = (unsigned int)std::atoi(argv[++i]);
+		else
+		{
+			PrintUsage();
+			return 1;
+		}
+	}
+
+	signal(SIGPIPE, SIG_IGN);
+	generator.seed(seed);
+
+	epoll = epoll_create1(0);
+
+	auto start = std::chrono::steady_clock::now();
+
+	const int MaxEvents = 256;
+	epoll_event events[MaxEvents];
+
+	while (finished < total)
+	{
+		// The robots that finished are replaced until the total is reached
+		while (started < total && started - finished < concurrent)
+		{
+			if (!Connect())
+			{
+				std::cerr << "Cannot connect: " << std::strerror(errno) << std::endl;
+				return 1;
+			}
+		}
+
+		int ready = epoll_wait(epoll, events, MaxEvents, -1);
+		if (ready == -1)
+		{
+			if (errno == EINTR)
+				continue;
+
+			break;
+		}
+
+		for (int i = 0; i < ready; i++)
+			Receive((Robot*)events[i].data.ptr);
+	}
+
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::cout << finished << " sessions, " << solved << " solved, " << errors << " errors" << std::endl;
+	std::cout << moves << " moves, " << scans << " scans" << std::endl;
+	std::cout << seconds << " s, " << finished / seconds << " sessions/s, " << (moves + scans) / seconds << " frames/s" << std::endl;
+
+	close(epoll);
+
+	return errors == 0 ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,415 @@
+/*
+	Serves the solver to the robots connected over a local socket, every connection is a solve.
+
+	MazeSolverServer [--unix path | --port number] [--sessions count] [--stack bytes]
+
+	The solver calls the scan and the move functions and waits for them, so every session runs the solver
+	on its own stack. A scan or a move sends its frame and switches back to the event loop, which switches
+	to the session again when the reply arrives, so a single thread serves all of the robots.
+*/
+
+// Linux only, built with the sources of the solver:
+// g++ -std=c++14 -O2 -o MazeSolverServer server.cpp ../MazeSolverSimulation/maze/*.cpp -lpthread
+
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+
+#include <signal.h>
+#include <sys/epoll.h>
+#include <ucontext.h>
+
+#include "../MazeSolverSimulation/maze/mazesolver.h"
+#include "protocol.h"
+#include "socket.h"
+
+bool Scan(MazeSolver::Direction direction);
+void Move(MazeSolver::Direction direction);
+void MoveRun(MazeSolver::Direction direction, unsigned int count);
+bool Cancel();
+
+struct Session
+{
+	int Socket = -1;
+
+	MazeSolver::Solver Solver;
+	MazeSolver::Solution Solution = MazeSolver::Solution::PeriodicCorrection;
+
+	// The stack the solver runs on and where it stopped to wait
+	ucontext_t Context;
+	char* Stack = nullptr;
+
+	// The bytes of a frame that has not arrived whole yet
+	unsigned char Input[Protocol::FrameSize];
+	unsigned int InputSize = 0;
+
+	// The bytes the socket has not taken yet
+	unsigned char Output[4 * Protocol::FrameSize];
+	unsigned int OutputSize = 0;
+	bool Writing = false;
+
+	// The reply the solver is waiting for
+	Protocol::MessageType Awaited = Protocol::MessageType::Invalid;
+	Protocol::Frame Reply;
+	bool Replied = false;
+
+	bool Started = false;
+	bool Finished = false;
+	bool Closed = false;
+
+	Session()
+		: Solver(Scan, Move)
+	{
+		Solver.SetMoveRunFunction(MoveRun);
+
+		MazeSolver::Limits limits;
+		limits.Cancel = Cancel;
+		Solver.SetLimits(limits);
+	}
+};
+
+int epoll = -1;
+
+// The context of the event loop, the sessions switch back to it while they wait
+ucontext_t loopContext;
+
+// The session whose solver is running
+Session* running = nullptr;
+
+unsigned int stackSize = 256 * 1024;
+
+unsigned int sessionCount = 0;
+unsigned int solvedCount = 0;
+
+void Watch(Session* session)
+{
+	epoll_event event;
+	event.events = EPOLLIN | EPOLLRDHUP | (session->Writing ? (uint32_t)EPOLLOUT : 0u);
+	event.data.ptr = session;
+	epoll_ctl(epoll, EPOLL_CTL_MOD, session->Socket, &event);
+}
+
+void Flush(Session* session)
+{
+	while (session->OutputSize != 0)
+	{
+		ssize_t written = send(session->Socket, session->Output, session->OutputSize, MSG_NOSIGNAL);
+		if (written < 0)
+		{
+			if (errno == EINTR)
+				continue;
+
+			if (errno != EAGAIN && errno != EWOULDBLOCK)
+				session->Closed = true;
+
+			break;
+		}
+
+		session->OutputSize -= (unsigned int)written;
+		std::memmove(session->Output, session->Output + written, session->OutputSize);
+	}
+
+	// The rest is sent when the socket can take it
+	bool writing = session->OutputSize != 0 && !session->Closed;
+	if (writing != session->Writing)
+	{
+		session->Writing = writing;
+		Watch(session);
+	}
+}
+
+void Send(Session* session, Protocol::MessageType type, unsigned char argument, unsigned short count)
+{
+	if (session->Closed)
+		return;
+
+	if (session->OutputSize + Protocol::FrameSize > sizeof(session->Output))
+	{
+		// The robot stopped reading
+		session->Closed = true;
+		return;
+	}
+
+	Protocol::Frame frame;
+	frame.Type = type;
+	frame.Argument = argument;
+	frame.Count = count;
+	Protocol::Encode(frame, session->Output + session->OutputSize);
+	session->OutputSize += Protocol::FrameSize;
+
+	Flush(session);
+}
+
+bool Await(Protocol::MessageType type)
+{
+	Session* session = running;
+	session->Awaited = type;
+	session->Replied = false;
+
+	// The event loop switches back when the reply arrives or the connection closes
+	while (!session->Replied && !session->Closed)
+		swapcontext(&session->Context, &loopContext);
+
+	session->Awaited = Protocol::MessageType::Invalid;
+	return session->Replied;
+}
+
+bool Scan(MazeSolver::Direction direction)
+{
+	Send(running, Protocol::MessageType::Scan, (unsigned char)direction, 0);
+	if (!Await(Protocol::MessageType::ScanResult))
+		return false;
+
+	return running->Reply.Argument != 0;
+}
+
+void Move(MazeSolver::Direction direction)
+{
+	MoveRun(direction, 1);
+}
+
+void MoveRun(MazeSolver::Direction direction, unsigned int count)
+{
+	// The count of a frame has 16 bits
+	while (count != 0)
+	{
+		unsigned int part = count < 0xFFFF ? count : 0xFFFF;
+		count -= part;
+
+		Send(running, Protocol::MessageType::Move, (unsigned char)direction, (unsigned short)part);
+		if (!Await(Protocol::MessageType::MoveDone))
+			return;
+	}
+}
+
+bool Cancel()
+{
+	return running->Closed;
+}
+
+void Run()
+{
+	Session* session = running;
+
+	MazeSolver::SolveResult result = session->Solver.Solve(session->Solution);
+	if (result)
+		solvedCount++;
+
+	Send(session, Protocol::MessageType::Done, (unsigned char)result.Status, 0);
+	session->Finished = true;
+
+	// Returning switches to the event loop through the link of the context
+}
+
+void Destroy(Session* session)
+{
+	epoll_ctl(epoll, EPOLL_CTL_DEL, session->Socket, nullptr);
+	close(session->Socket);
+
+	delete[] session->Stack;
+	delete session;
+
+	sessionCount++;
+}
+
+void Resume(Session* session)
+{
+	running = session;
+	swapcontext(&loopContext, &session->Context);
+	running = nullptr;
+}
+
+bool Start(Session* session, const Protocol::Frame& frame)
+{
+	switch (frame.Argument)
+	{
+	case (unsigned char)MazeSolver::Solution::PeriodicCorrection:
+	case (unsigned char)MazeSolver::Solution::AlgorithmicRunner:
+	case (unsigned char)MazeSolver::Solution::FrontierExploration:
+	case (unsigned char)MazeSolver::Solution::BestFirstRunner:
+	case (unsigned char)MazeSolver::Solution::WallFollower:
+		session->Solution = (MazeSolver::Solution)frame.Argument;
+		break;
+	default:
+		return false;
+	}
+
+	session->Stack = new char[stackSize];
+
+	getcontext(&session->Context);
+	session->Context.uc_stack.ss_sp = session->Stack;
+	session->Context.uc_stack.ss_size = stackSize;
+	session->Context.uc_link = &loopContext;
+	makecontext(&session->Context, Run, 0);
+
+	session->Started = true;
+	Resume(session);
+
+	return true;
+}
+
+void Receive(Session* session)
+{
+	while (!session->Closed && !session->Finished)
+	{
+		ssize_t received = recv(session->Socket, session->Input + session->InputSize, Protocol::FrameSize - session->InputSize, 0);
+		if (received <= 0)
+		{
+			if (received < 0 && errno == EINTR)
+				continue;
+
+			if (received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK))
+				session->Closed = true;
+
+			break;
+		}
+
+		session->InputSize += (unsigned int)received;
+		if (session->InputSize != Protocol::FrameSize)
+			continue;
+
+		session->InputSize = 0;
+		Protocol::Frame frame = Protocol::Decode(session->Input);
+
+		if (!session->Started)
+		{
+			if (frame.Type != Protocol::MessageType::Hello || !Start(session, frame))
+				session->Closed = true;
+
+			continue;
+		}
+
+		// Only the reply the solver waits for is expected
+		if (frame.Type != session->Awaited)
+		{
+			session->Closed = true;
+			break;
+		}
+
+		session->Reply = frame;
+		session->Replied = true;
+		Resume(session);
+	}
+}
+
+void Update(Session* session)
+{
+	// A solver that waits on a closed connection is switched to once more to be cancelled
+	if (session->Closed && session->Started && !session->Finished)
+		Resume(session);
+
+	if (session->Closed || (session->Finished && session->OutputSize == 0))
+		Destroy(session);
+}
+
+void Accept(int listener)
+{
+	while (true)
+	{
+		int accepted = accept(listener, nullptr, nullptr);
+		if (accepted == -1)
+			return;
+
+		if (!Socket::SetNonBlocking(accepted))
+		{
+			close(accepted);
+			continue;
+		}
+
+		Session* session = new Session();
+		session->Socket = accepted;
+
+		epoll_event event;
+		event.events = EPOLLIN | EPOLLRDHUP;
+		event.data.ptr = session;
+		epoll_ctl(epoll, EPOLL_CTL_ADD, accepted, &event);
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	const char* unixPath = nullptr;
+	int port = 7878;
+	unsigned int maxSessions = 0;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::strcmp(argv[i], "--unix") == 0 && i + 1 < argc)
+			unixPath = argv[++i];
+		else if (std::strcmp(argv[i], "--port") == 0 && i + 1 < argc)
+			port = std::atoi(argv[++i]);
+		else if (std::strcmp(argv[i], "--sessions") == 0 && i + 1 < argc)
+			maxSessions = (unsigned int)std::atoi(argv[++i]);
+		else if (std::strcmp(argv[i], "--stack") == 0 && i + 1 < argc)
+			stackSize = (unsigned int)std::atoi(argv[++i]);
+		else
+		{
+			std::cerr << "Usage: MazeSolverServer [--unix path | --port number] [--sessions count] [--stack bytes]" << std::endl;
+			return 1;
+		}
+	}
+
+	signal(SIGPIPE, SIG_IGN);
+
+	int listener = Socket::Open(unixPath, port, true);
+	if (listener == -1 || !Socket::SetNonBlocking(listener))
+	{
+		std::cerr << "Cannot listen: " << std::strerror(errno) << std::endl;
+		return 1;
+	}
+
+	epoll = epoll_create1(0);
+
+	epoll_event event;
+	event.events = EPOLLIN;
+	event.data.ptr = nullptr;
+	epoll_ctl(epoll, EPOLL_CTL_ADD, listener, &event);
+
+	if (unixPath != nullptr)
+		std::cout << "Listening on " << unixPath << std::endl;
+	else
+		std::cout << "Listening on 127.0.0.1:" << port << std::endl;
+
+	const int MaxEvents = 256;
+	epoll_event events[MaxEvents];
+
+	while (maxSessions == 0 || sessionCount < maxSessions)
+	{
+		int ready = epoll_wait(epoll, events, MaxEvents, -1);
+		if (ready == -1)
+		{
+			if (errno == EINTR)
+				continue;
+
+			break;
+		}
+
+		for (int i = 0; i < ready; i++)
+		{
+			Session* session = (Session*)events[i].data.ptr;
+			if (session == nullptr)
+			{
+				Accept(listener);
+				continue;
+			}
+
+			if (events[i].events & EPOLLOUT)
+				Flush(session);
+
+			if (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))
+				Receive(session);
+
+			Update(session);
+		}
+	}
+
+	close(listener);
+	close(epoll);
+	if (unixPath != nullptr)
+		unlink(unixPath);
+
+	std::cout << sessionCount << " sessions, " << solvedCount << " solved" << std::endl;
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstring>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace Socket
+{
+
+	/// <summary>
+	/// Makes the calls on a socket return instead of waiting.
+	/// </summary>
+	/// <param name="socket">The socket.</param>
+	/// <returns>True if the socket is non-blocking, false otherwise.</returns>
+	inline bool SetNonBlocking(int socket)
+	{
+		int flags = fcntl(socket, F_GETFL, 0);
+		return flags != -1 && fcntl(socket, F_SETFL, flags | O_NONBLOCK) != -1;
+	}
+
+	/// <summary>
+	/// Opens a socket, on a Unix-domain path if one is given, on a loopback port otherwise.
+	/// </summary>
+	/// <param name="unixPath">The path of the Unix-domain socket, or null.</param>
+	/// <param name="port">The loopback port.</param>
+	/// <param name="listening">True to listen on the socket, false to connect to it.</param>
+	/// <returns>The socket, -1 if it could not be opened.</returns>
+	inline int Open(const char* unixPath, int port, bool listening)
+	{
+		int opened;
+		int result;
+
+		if (unixPath != nullptr)
+		{
+			sockaddr_un address;
+			std::memset(&address, 0, sizeof(address));
+			address.sun_family = AF_UNIX;
+			std::strncpy(address.sun_path, unixPath, sizeof(address.sun_path) - 1);
+
+			opened = socket(AF_UNIX, SOCK_STREAM, 0);
+			if (opened == -1)
+				return -1;
+
+			if (listening)
+			{
+				// A socket file left by an earlier server is replaced
+				unlink(unixPath);
+				result = bind(opened, (sockaddr*)&address, sizeof(address));
+			}
+			else
+			{
+				result = connect(opened, (sockaddr*)&address, sizeof(address));
+			}
+		}
+		else
+		{
+			sockaddr_in address;
+			std::memset(&address, 0, sizeof(address));
+			address.sin_family = AF_INET;
+			address.sin_port = htons((unsigned short)port);
+			address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+			opened = socket(AF_INET, SOCK_STREAM, 0);
+			if (opened == -1)
+				return -1;
+
+			// The frames are small and every one of them is waited for
+			int enabled = 1;
+			setsockopt(opened, IPPROTO_TCP, TCP_NODELAY, &enabled, sizeof(enabled));
+
+			if (listening)
+			{
+				setsockopt(opened, SOL_SOCKET, SO_REUSEADDR, &enabled, sizeof(enabled));
+				result = bind(opened, (sockaddr*)&address, sizeof(address));
+			}
+			else
+			{
+				result = connect(opened, (sockaddr*)&address, sizeof(address));
+			}
+		}
+
+		if (result == 0 && listening)
+			result = listen(opened, SOMAXCONN);
+
+		if (result != 0)
+		{
+			close(opened);
+			return -1;
+		}
+
+		return opened;
+	}
+
+}
\ No newline at end of file
@@ -3,10 +3,8 @@
 #include <chrono>
 #include <limits>
 
-#define NOMINMAX
-#include <Windows.h>
-
 #include "maze/mazesolver.h"
+#include "renderer.h"
 
 const char* const directions[]
 {
@@ -19,11 +17,10 @@ const char* const directions[]
 
 bool Scan(MazeSolver::Direction direction);
 void Move(MazeSolver::Direction direction);
+double Clock();
 
-void DrawMaze(int point);
-void DrawMaze(MazeSolver::List<int> points);
-
-void SetCursorToStartOfTheMaze();
+const int Width = MazeSolver::Solver::Width;
+const int Height = MazeSolver::Solver::Height;
 
 // Obstacles
 MazeSolver::List<MazeSolver::Obstacle> obstacles;
@@ -31,32 +28,17 @@ MazeSolver::List<MazeSolver::Obstacle> obstacles;
 // The maze
 MazeSolver::Solver maze(Scan, Move);
 
+// Draws at most 30 frames per second however fast the solver moves
+Renderer renderer(Width, Height, 30);
+
+// The point the runner has really moved to, the solver is ahead of it while the moves are queued
+int runnerPoint = maze.StartPoint;
+
 bool Scan(MazeSolver::Direction direction)
 {
-	int point = 0;
-	switch (direction)
-	{
-	case MazeSolver::Direction::Up:
-		point = maze.CurrentPoint + 5;
-		break;
-	case MazeSolver::Direction::Right:
- 	   point = maze.CurrentPoint + 1;
-		break;
-	case MazeSolver::Direction::Left:
-		point = maze.CurrentPoint - 1;
-		break;
-	case MazeSolver::Direction::Down:
-		point = maze.CurrentPoint - 5;
-		break;
-	}
+	int point = MazeSolver::Topology::GetAdjacent(direction, maze.CurrentPoint);
 
-	bool found = false;
-	for (MazeSolver::Obstacle &obstacle : obstacles)
-	{
-		if ((obstacle.First == maze.CurrentPoint && obstacle.Second == point) ||
-			(obstacle.First == point && obstacle.Second == maze.CurrentPoint))
-			found = true;
-	}
+	bool found = renderer.HasWall(maze.CurrentPoint, point);
 
 	// std::cout << "Scanning " << directions[((int)direction)] << ": " << (found ? "Obstacle" : "Path") << std::endl;
 
@@ -67,12 +49,16 @@ void Move(MazeSolver::Direction direction)
 {
 	// std::cout << "-> " << directions[((int)direction)] << std::endl;
 
-	SetCursorToStartOfTheMaze();
-
 	using namespace std::literals::chrono_literals;
 	std::this_thread::sleep_for(1s);
 
-	DrawMaze(maze.CurrentPoint);
+	runnerPoint = MazeSolver::Topology::GetAdjacent(direction, runnerPoint);
+	renderer.Move(runnerPoint);
+}
+
+double Clock()
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
 }
 
 int main()
@@ -104,7 +90,7 @@ int main()
 		}
 
 		if (obstacle.First < 0 || obstacle.Second < 0 ||
-			obstacle.First >= 25 || obstacle.Second >= 25)
+			obstacle.First >= Width * Height || obstacle.Second >= Width * Height)
 		{
 			std::cout << "Invalid obstacle (points don't exist)." << std::endl;
 			continue;
@@ -117,8 +103,14 @@ int main()
 			obstacle.Second ^= obstacle.First;
 		}
 
-		int difference = obstacle.Second - obstacle.First;
-		if (difference != 1 && difference != 5)
+		bool adjacent = false;
+		for (unsigned int i = 0; i < MazeSolver::Topology::Directions; i++)
+		{
+			if (MazeSolver::Topology::GetAdjacent(MazeSolver::Topology::GetDirection(i), obstacle.First) == obstacle.Second)
+				adjacent = true;
+		}
+
+		if (!adjacent)
 		{
 			std::cout << "Invalid obstacle (points aren't adjacent)." << std::endl;
 			continue;
@@ -134,127 +126,49 @@ int main()
 		}
 
 		obstacles.Push(obstacle);
+		renderer.AddWall(obstacle.First, obstacle.Second);
 	}
 
 	std::cout << std::endl;
 
-	// DrawMaze(maze.CurrentPoint);
+	// renderer.Draw(maze.CurrentPoint);
 	// bool solved = maze.Solve(MazeSolver::Solution::AlgorithmicRunner);
 
 	/*
 	MazeSolver::Stack<int> path;
 	bool solved = maze.GetShortestPath(0, obstacles, path);
-	path.Push(0);
-	DrawMaze(path.ToList());
+	renderer.Draw(0);
+	for (int point : path)
+		renderer.Highlight(point);
+	renderer.Finish();
 	*/
 
-	DrawMaze(maze.CurrentPoint);
+	// Every move waits for a second
+	MazeSolver::CostModel costModel;
+	costModel.MoveCost = 1000;
+	costModel.Clock = Clock;
+	maze.SetCostModel(costModel);
+
+	renderer.Draw(maze.CurrentPoint);
 	bool solved = maze.Solve(MazeSolver::Solution::PeriodicCorrection); // MazeSolver::Solution::PeriodicCorrection
+	renderer.Finish();
+
+#if defined MAZESOLVER_TRACING
+	// Open the file in chrome://tracing or ui.perfetto.dev
+	MazeSolver::Tracer::Write("maze.trace.json");
+#endif
 
 	std::cout << "The maze " << (solved ? "is" : "cannot be") << " solved." << std::endl;
 
+	const MazeSolver::CostReport& report = maze.GetReport();
+	std::cout << report.Moves << " moves, " << report.Scans << " scans, " << report.Turns << " turns, " << report.Plans << " searches" << std::endl;
+	std::cout << "Predicted time: " << report.PredictedTime << " ms, actual time: " << report.ActualTime << " ms" << std::endl;
+	if (report.ContingencyPlans != 0)
+		std::cout << report.ContingencyHits << " of " << report.ContingencyPlans << " searches done while moving were used" << std::endl;
+
 	std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
 	std::cin.clear();
 	std::cin.get();
 
 	return 0;
-}
-
-void DrawMaze(int point)
-{
-	MazeSolver::List<int> points;
-	points.Push(point);
-
-	DrawMaze(points);
-}
-
-void DrawMaze(MazeSolver::List<int> points)
-{
-	std::string screen = "-----------\n";
-	for (int i = 4; i >= 0; i--)
-	{
-		screen += "|";
-		for (int j = 0; j < 5; j++)
-		{
-			int drawPoint = i * 5 + j;
-			bool specialPoint = false;
-
-			for (int point : points)
-			{
-				if (point == drawPoint)
-				{
-					specialPoint = true;
-					break;
-				}
-			}
-
-			screen += (specialPoint ? "O" : "*");
-
-			if (j != 4)
-			{
-				bool foundObstacle = false;
-				for (MazeSolver::Obstacle &obstacle : obstacles)
-				{
-					if ((obstacle.First == drawPoint && obstacle.Second == drawPoint + 1) ||
-						(obstacle.First == drawPoint + 1 && obstacle.Second == drawPoint))
-					{
-						foundObstacle = true;
-						break;
-					}
-				}
-
-				if (foundObstacle)
-					screen += "|";
-				else
-					screen += " ";
-			}
-		}
-		screen += "|\n";
-
-		if (i != 0)
-		{
-			screen += "|";
-			for (int j = 0; j < 5; j++)
-			{
-				bool foundObstacle = false;
-				for (MazeSolver::Obstacle &obstacle : obstacles)
-				{
-					if ((obstacle.First == i * 5 + j && obstacle.Second == (i - 1) * 5 + j) ||
-						(obstacle.First == (i - 1) * 5 + j && obstacle.Second == i * 5 + j))
-					{
-						foundObstacle = true;
-						break;
-					}
-				}
-
-				if (foundObstacle)
-					screen += "-";
-				else
-					screen += " ";
-
-				if (j != 4)
-					screen += " ";
-			}
-			screen += "|\n";
-		}
-	}
-	screen += "-----------\n";
-
-	std::cout << screen;
-}
-
-void SetCursorToStartOfTheMaze()
-{
-	const int length = 132;
-
-	// HANDLE console = CreateConsoleScreenBuffer(GENERIC_READ, 0, NULL, CONSOLE_TEXTMODE_BUFFER, NULL);
-	HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
-
-	CONSOLE_SCREEN_BUFFER_INFO consoleInfo;
-	GetConsoleScreenBufferInfo(console, &consoleInfo);
-
-	COORD coordinates = consoleInfo.dwCursorPosition;
-	coordinates.Y -= 11;
-
-	SetConsoleCursorPosition(console, coordinates);
 }
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include "actuator.h"
+
+#if defined MAZESOLVER_ASYNC_MOTION
+
+MazeSolver::Actuator::Actuator()
+{
+}
+
+MazeSolver::Actuator::~Actuator()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	wake.notify_one();
+
+	if (thread.joinable())
+		thread.join();
+}
+
+void MazeSolver::Actuator::SetFunctions(MovementFunction moveFunction, MoveRunFunction moveRunFunction)
+{
+	// The functions are read by the thread only while it moves, which is never during a change
+	Wait(sent);
+
+	this->moveFunction = moveFunction;
+	this->moveRunFunction = moveRunFunction;
+}
+
+unsigned int MazeSolver::Actuator::Send(Direction direction, unsigned int count)
+{
+	Start();
+
+	Command command;
+	command.MoveDirection = direction;
+	command.Count = count;
+
+	if (!commands.TryPush(command))
+	{
+		// The runner is too far behind, a move has to finish first
+		std::unique_lock<std::mutex> lock(mutex);
+		done.wait(lock, [this] { return !commands.IsFull(); });
+		lock.unlock();
+
+		commands.TryPush(command);
+	}
+
+	{
+		// The thread checks the queue under the lock, so it cannot miss the command
+		std::lock_guard<std::mutex> lock(mutex);
+	}
+	wake.notify_one();
+
+	return ++sent;
+}
+
+bool MazeSolver::Actuator::IsDone(unsigned int ticket)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return finished >= ticket;
+}
+
+void MazeSolver::Actuator::Wait(unsigned int ticket)
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	done.wait(lock, [this, ticket] { return finished >= ticket; });
+}
+
+void MazeSolver::Actuator::Start()
+{
+	if (thread.joinable())
+		return;
+
+	thread = std::thread(&Actuator::Work, this);
+}
+
+void MazeSolver::Actuator::Work()
+{
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			wake.wait(lock, [this] { return stopping || !commands.IsEmpty(); });
+
+			// The queued moves are finished before stopping
+			if (commands.IsEmpty())
+				return;
+		}
+
+		// Only this thread pops, so the command seen above is still queued
+		Command command;
+		if (!commands.TryPop(command))
+			continue;
+
+		{
+			MAZESOLVER_TRACE_SCOPE("Move");
+
+			if (command.Count == 1)
+				moveFunction(command.MoveDirection);
+			else
+				moveRunFunction(command.MoveDirection, command.Count);
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			finished++;
+		}
+		done.notify_all();
+	}
+}
+
+#endif
\ No newline at end of file
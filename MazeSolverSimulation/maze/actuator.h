@@ -0,0 +1,119 @@
+#pragma once
+
+#include "config.h"
+
+#include "topology.h"
+
+namespace MazeSolver
+{
+
+	/// <summary>
+	/// A function type for the movement function with signature:
+	/// void Move(int point)
+	/// </summary>
+	/// <param>The direction of the adjacent point to move to.</param>
+	using MovementFunction = void (*)(Direction);
+
+	/// <summary>
+	/// A function type for the run function with signature:
+	/// void MoveRun(Direction direction, unsigned int count)
+	/// </summary>
+	/// <param>The direction to move in.</param>
+	/// <param>The number of points to move straight.</param>
+	using MoveRunFunction = void (*)(Direction, unsigned int);
+
+}
+
+#if defined MAZESOLVER_ASYNC_MOTION
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "commandqueue.h"
+#include "tracer.h"
+
+namespace MazeSolver
+{
+
+	// Moves the runner on a thread of its own, the moves are queued and the caller does not wait for them
+	class Actuator
+	{
+
+	public:
+		// The number of commands that can wait for the runner
+		static const unsigned int QueueSize = MAZESOLVER_MOTION_QUEUE_SIZE;
+
+	public:
+		/// <summary>
+		/// Constructor.
+		/// </summary>
+		Actuator();
+
+		/// <summary>
+		/// Destructor, the queued moves are finished first.
+		/// </summary>
+		~Actuator();
+
+		/// <summary>
+		/// Sets the functions that move the runner.
+		/// </summary>
+		/// <param name="moveFunction">Function that provides movement between adjacent cells.</param>
+		/// <param name="moveRunFunction">Function that moves straight, or null to move point by point.</param>
+		void SetFunctions(MovementFunction moveFunction, MoveRunFunction moveRunFunction);
+
+		/// <summary>
+		/// Queues a move, waits only if the queue is full.
+		/// </summary>
+		/// <param name="direction">The direction to move in.</param>
+		/// <param name="count">The number of points to move straight.</param>
+		/// <returns>The ticket of the move, the runner has finished it once the ticket is done.</returns>
+		unsigned int Send(Direction direction, unsigned int count);
+
+		/// <summary>
+		/// Checks whether a move is finished.
+		/// </summary>
+		/// <param name="ticket">The ticket of the move.</param>
+		/// <returns>True if the runner has finished the move, false otherwise.</returns>
+		bool IsDone(unsigned int ticket);
+
+		/// <summary>
+		/// Waits until a move and every move before it are finished.
+		/// </summary>
+		/// <param name="ticket">The ticket of the move.</param>
+		void Wait(unsigned int ticket);
+
+	private:
+		struct Command
+		{
+			Direction MoveDirection;
+			unsigned int Count;
+		};
+
+	private:
+		void Start();
+		void Work();
+
+	private:
+		MovementFunction moveFunction = nullptr;
+		MoveRunFunction moveRunFunction = nullptr;
+
+		// Links the solver, which produces the moves, with the thread that performs them
+		CommandQueue<Command, QueueSize> commands;
+
+		// The tickets of the last sent and the last finished move
+		unsigned int sent = 0;
+		unsigned int finished = 0;
+
+		// Only sleeping and waking up are locked, the commands are not
+		std::thread thread;
+		std::mutex mutex;
+		std::condition_variable wake;
+		std::condition_variable done;
+		bool stopping = false;
+
+	};
+
+}
+
+#endif
\ No newline at end of file
@@ -6,25 +6,28 @@ bool MazeSolver::Solver::AlgorithmicRunnerSolution()
 		let I be a runner
 		let M be a maze
 		let S be a stack
-		let B be a path
+		let R be a path
 		let p be a point
 		p = start
 		S.Push(p)
 		do
 			p = S.Pop()
-			if p is not adjacent or not accessible
-				I.Backtrack(B) until p is adjacent and accessible
-				B.Minus()
-
-			B.Plus()
-			I.Go(p)
+			if p is pruned
+				continue
+			if p is not I.CurrentPoint
+				if the edge to p is not known to be open
+					if the walls enclose I
+						end
+					R = shortest route to p along the known open edges
+					I.Go(R)
+				I.Go(p)
 
 			if p is the exit
 				end
 
 			label p as discovered
 			for w in M.AdjacentEdges(p)
-				if w is not discovered and is accessible and not in S
+				if w is not discovered and not pruned and not in S and is accessible
 					S.Push(w)
 		while S is not empty
 	*/
@@ -32,70 +35,115 @@ bool MazeSolver::Solver::AlgorithmicRunnerSolution()
 	if (CurrentPoint == EndPoint)
 		return true;
 
-	List<int> memory;
-	Stack<int> path;
+	CandidateList& memory = runnerMemory;
+	Path& route = runnerRoute;
 
+	if (!resuming)
+	{
+		memory.Clear();
+		ClearRemembered();
+	}
+	else
+	{
+		// The point the runner was going to is remembered but no longer in the memory
+		ClearVisited();
+		for (int rememberedPoint : memory)
+			Visit(rememberedPoint);
+
+		for (int rememberedPoint = 0; rememberedPoint < (int)(Width * Height); rememberedPoint++)
+		{
+			if (rememberedPoint != CurrentPoint && IsRemembered(rememberedPoint) && !IsVisited(rememberedPoint))
+				memory.Push(rememberedPoint);
+		}
+	}
+
+	// The current point is searched around first, a resumed solve may have stopped before it was
 	int point = CurrentPoint;
 	memory.Push(point);
+	Remember(point);
 	do
 	{
 		point = memory.Pop();
 
+		// The point became a dead end after it was remembered
+		if (CurrentPoint != point && IsPruned(point))
+		{
+			Forget(point);
+			continue;
+		}
+
 		if (CurrentPoint != point)
 		{
-			if (!IsAdjacent(point) || !IsAccessible(point)) // There are no direct paths
+			// Every remembered point was found accessible from a discovered point,
+			// so instead of backtracking, the runner takes the shortest route it knows to there
+			if (!IsAdjacent(point) || !IsOpen(point, CurrentPoint))
 			{
-				// Backtrack
-				bool foundNextPoint = false;
-				while (!path.IsEmpty())
-				{
-					int parent = path.Pop();
-					Move(parent);
-
-					// 4 possible directions
-					for (unsigned int i = 0; i < 4; i++)
-					{
-						int adjacent = GetAdjacent(i);
-						if (adjacent == point && IsAccessible(adjacent))
-						{
-							foundNextPoint = true;
-							break;
-						}
-					}
-
-					if (foundNextPoint)
-						break;
-				}
+				MAZESOLVER_TRACE_SCOPE("Route");
+
+				// Going back is pointless if the known walls enclose the runner
+				if (!IsExitReachable())
+					return false;
 
-				// The point should always be found by backtracking
-#if defined MAZESOLVER_ASSERTS_ALLOWED
-				assert(foundNextPoint);
+				bool routeFound = GetKnownRoute(CurrentPoint, point, route);
+
+				// The discovered points are connected through the edges the runner moved along,
+				// only a tile of the storage that could not be mapped loses the route
+#if defined MAZESOLVER_ASSERTS_ALLOWED && !defined MAZESOLVER_TILED_STORAGE
+				assert(routeFound);
 #endif
+				if (!routeFound)
+					return false;
+
+				// The last point of the route is the remembered one
+				while (route.Peek() != point)
+				{
+					if (!CanMove())
+						return false;
+
+					Move(route.Pop());
+				}
 			}
 
-			path.Push(CurrentPoint);
+			if (!CanMove())
+				return false;
+
 			Move(point);
 
 			if (point == EndPoint) // Reached the end
 				return true;
 		}
 
+		// The point is remembered until the runner gets there, so that a resumed solve still goes there
+		Forget(point);
 		Discover(point);
 
-		// 4 possible directions
-		for (unsigned int i = 0; i < 4; i++)
+		// Every possible direction
+		for (unsigned int i = 0; i < Topology::Directions; i++)
 		{
 			int adjacent = GetAdjacent(i);
-			if (IsDiscovered(adjacent) || !IsAccessible(adjacent))
+			if (adjacent == -1 || IsDiscovered(adjacent) || IsPruned(adjacent))
+				continue;
+
+			// Already remembered, it's reached through the point that found it
+			if (IsRemembered(adjacent))
 				continue;
 
-			for (int memorizedPoint : memory)
+			// The wall was scanned before the solve was resumed
+			if (IsClosed(adjacent, CurrentPoint))
+				continue;
+
+			// The edges along the ray of a range scan are known to be open without scanning
+			if (!IsOpen(adjacent, CurrentPoint))
 			{
-				if (memorizedPoint == adjacent)
+				if (!CanScan())
+					return false;
+
+				if (!IsAccessible(adjacent))
 					continue;
 			}
 
 			memory.Push(adjacent);
+			Remember(adjacent);
 		}
 	}
 	while (!memory.IsEmpty());
@@ -0,0 +1,158 @@
+#include "batchplanner.h"
+
+MazeSolver::BatchPlanner::BatchPlanner()
+{
+	// Every edge is listed once, from its lower point
+	for (int point = 0; point < (int)Cells; point++)
+	{
+		for (unsigned int i = 0; i < Topology::Directions; i++)
+		{
+			int adjacent = Topology::GetAdjacent(Topology::GetDirection(i), point);
+			if (adjacent <= point)
+				continue;
+
+			Edge& edge = edges[edgeCount++];
+			edge.First = point;
+			edge.Second = adjacent;
+			edge.Index = Topology::GetEdge(point, adjacent);
+		}
+	}
+
+	Clear();
+}
+
+void MazeSolver::BatchPlanner::Clear()
+{
+	for (unsigned int edge = 0; edge < Topology::Edges; edge++)
+	{
+		for (unsigned int word = 0; word < Words; word++)
+			walls[edge][word] = 0;
+	}
+
+	for (unsigned int lane = 0; lane < Lanes; lane++)
+		distances[lane] = Unreachable;
+
+	for (unsigned int word = 0; word < Words; word++)
+		found[word] = 0;
+}
+
+void MazeSolver::BatchPlanner::AddWall(unsigned int lane, int first, int second)
+{
+#if defined MAZESOLVER_ASSERTS_ALLOWED
+	assert(lane < Lanes);
+#endif
+
+	unsigned int edge = Topology::GetEdge(first, second);
+	walls[edge][lane / 64] |= (Word)1 << (lane % 64);
+}
+
+unsigned int MazeSolver::BatchPlanner::Search(int initialPoint, int endPoint)
+{
+	/*
+		let R be the lanes that have reached every point
+		let F be the lanes that have reached every point in the last step
+
+		R[start] = F[start] = every lane
+		distance = 0
+		while F is not empty in any point
+			for l in F[end]
+				l.Distance = distance
+			F[end] = 0
+
+			for (p, w) in M.Edges
+				N[p] |= F[w] & there is no wall between p and w
+				N[w] |= F[p] & there is no wall between p and w
+			for p in M.Points
+				F[p] = N[p] & ~R[p] & ~the lanes that reached the exit
+				R[p] |= F[p]
+			distance++
+	*/
+
+	for (unsigned int point = 0; point < Cells; point++)
+	{
+		for (unsigned int word = 0; word < Words; word++)
+		{
+			reached[point][word] = 0;
+			frontier[point][word] = 0;
+		}
+	}
+
+	for (unsigned int lane = 0; lane < Lanes; lane++)
+		distances[lane] = Unreachable;
+
+	for (unsigned int word = 0; word < Words; word++)
+	{
+		reached[initialPoint][word] = ~(Word)0;
+		frontier[initialPoint][word] = ~(Word)0;
+		found[word] = 0;
+	}
+
+	unsigned int count = 0;
+	for (unsigned int distance = 0; ; distance++)
+	{
+		// The lanes that reach the exit stop searching, the search ends when no lane moves
+		for (unsigned int word = 0; word < Words; word++)
+		{
+			Word arrived = frontier[endPoint][word];
+			frontier[endPoint][word] = 0;
+
+			if (arrived == 0)
+				continue;
+
+			found[word] |= arrived;
+			for (unsigned int bit = 0; bit < 64; bit++)
+			{
+				if (arrived & ((Word)1 << bit))
+				{
+					distances[word * 64 + bit] = distance;
+					count++;
+				}
+			}
+		}
+
+		for (unsigned int point = 0; point < Cells; point++)
+		{
+			for (unsigned int word = 0; word < Words; word++)
+				next[point][word] = 0;
+		}
+
+		for (unsigned int i = 0; i < edgeCount; i++)
+		{
+			const Edge& edge = edges[i];
+
+			for (unsigned int word = 0; word < Words; word++)
+			{
+				Word open = ~walls[edge.Index][word];
+				next[edge.First][word] |= frontier[edge.Second][word] & open;
+				next[edge.Second][word] |= frontier[edge.First][word] & open;
+			}
+		}
+
+		Word moved = 0;
+		for (unsigned int point = 0; point < Cells; point++)
+		{
+			for (unsigned int word = 0; word < Words; word++)
+			{
+				Word reachedNow = next[point][word] & ~reached[point][word] & ~found[word];
+				frontier[point][word] = reachedNow;
+				reached[point][word] |= reachedNow;
+				moved |= reachedNow;
+			}
+		}
+
+		if (moved == 0)
+			break;
+	}
+
+	return count;
+}
+
+bool MazeSolver::BatchPlanner::IsReachable(unsigned int lane)
+{
+	return (found[lane / 64] & ((Word)1 << (lane % 64))) != 0;
+}
+
+unsigned int MazeSolver::BatchPlanner::GetDistance(unsigned int lane)
+{
+	return distances[lane];
+}
\ No newline at end of file
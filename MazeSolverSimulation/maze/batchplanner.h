@@ -0,0 +1,101 @@
+#pragma once
+
+#include "config.h"
+
+#if defined MAZESOLVER_ASSERTS_ALLOWED
+#include <cassert>
+#endif
+
+#include "topology.h"
+
+namespace MazeSolver
+{
+
+	// Breadth-first search over many mazes of the same size at once, bit i of every word belongs to the maze in lane i.
+	// One step of the search moves the frontiers of all of the lanes with a few bitwise operations per edge
+	class BatchPlanner
+	{
+
+	public:
+		// The dimensions of the maze
+		static const unsigned int Width = MAZESOLVER_WIDTH;
+		static const unsigned int Height = MAZESOLVER_HEIGHT;
+		static const unsigned int Cells = Width * Height;
+
+		// A lane is a bit of one of the words kept for every point and edge
+		static const unsigned int Words = MAZESOLVER_BATCH_WORDS;
+		static const unsigned int Lanes = Words * 64;
+
+		// The distance of a lane whose exit cannot be reached
+		static const unsigned int Unreachable = 0xFFFFFFFF;
+
+	public:
+		/// <summary>
+		/// Constructor, every edge of every lane is open.
+		/// </summary>
+		BatchPlanner();
+
+		/// <summary>
+		/// Opens every edge of every lane.
+		/// </summary>
+		void Clear();
+
+		/// <summary>
+		/// Adds a wall to the maze of a lane.
+		/// </summary>
+		/// <param name="lane">The lane of the maze.</param>
+		/// <param name="first">The first point.</param>
+		/// <param name="second">The second point.</param>
+		void AddWall(unsigned int lane, int first, int second);
+
+		/// <summary>
+		/// Searches the shortest paths from a point to the exit in every lane.
+		/// </summary>
+		/// <param name="initialPoint">The starting point.</param>
+		/// <param name="endPoint">The exit point.</param>
+		/// <returns>The number of lanes whose exit is reachable.</returns>
+		unsigned int Search(int initialPoint, int endPoint);
+
+		/// <summary>
+		/// Checks whether the last search reached the exit in a lane.
+		/// </summary>
+		/// <param name="lane">The lane of the maze.</param>
+		/// <returns>True if the exit is reachable, false otherwise.</returns>
+		bool IsReachable(unsigned int lane);
+
+		/// <summary>
+		/// Gets the length of the shortest path found by the last search in a lane.
+		/// </summary>
+		/// <param name="lane">The lane of the maze.</param>
+		/// <returns>The number of moves to the exit, unreachable if the exit cannot be reached.</returns>
+		unsigned int GetDistance(unsigned int lane);
+
+	private:
+		typedef unsigned long long Word;
+
+		// An edge that exists in the topology, searched from both of its points
+		struct Edge
+		{
+			int First;
+			int Second;
+			unsigned int Index;
+		};
+
+	private:
+		// The walls of every lane, indexed by the edge of the topology
+		Word walls[Topology::Edges][Words];
+
+		Edge edges[Topology::Edges];
+		unsigned int edgeCount = 0;
+
+		// The lanes that have reached a point and the lanes that reached it in the last step
+		Word reached[Cells][Words];
+		Word frontier[Cells][Words];
+		Word next[Cells][Words];
+
+		Word found[Words];
+		unsigned int distances[Lanes];
+
+	};
+
+}
\ No newline at end of file
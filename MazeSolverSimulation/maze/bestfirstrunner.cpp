@@ -0,0 +1,215 @@
+#include "mazesolver.h"
+
+bool MazeSolver::Solver::BestFirstRunnerSolution()
+{
+	/*
+		let I be a runner
+		let M be a maze
+		let F be the frontier, the points found accessible but not discovered
+		let R be a path
+
+		repeat
+			if I reached the exit
+				end
+
+			label I.CurrentPoint as discovered
+			for w in M.AdjacentEdges(I.CurrentPoint)
+				if w is not discovered and not pruned and the edge to w is not known and is accessible
+					F.Add(w)
+
+			if the walls enclose I
+				end
+			R = shortest route along the known open edges to the point of F
+				with the lowest length of the route plus the estimated distance to the exit
+			if R is not found
+				end
+			I.Go(R)
+	*/
+
+	// A resumed solve keeps the frontier of the saved one
+	if (!resuming)
+		ClearRemembered();
+
+	Path& route = runnerRoute;
+
+	while (true)
+	{
+		if (CurrentPoint == EndPoint) // Reached the end
+			return true;
+
+		Forget(CurrentPoint);
+		Discover(CurrentPoint);
+
+		// Every possible direction
+		for (unsigned int i = 0; i < Topology::Directions; i++)
+		{
+			int adjacent = GetAdjacent(i);
+			if (adjacent == -1 || IsDiscovered(adjacent) || IsClosed(adjacent, CurrentPoint))
+				continue;
+
+			// Known to be open from a range scan, or already in the frontier
+			if (IsOpen(adjacent, CurrentPoint))
+			{
+				Remember(adjacent);
+				continue;
+			}
+
+			// The exit cannot be reached through the point, so it's not worth a scan
+			if (IsPruned(adjacent) || GetEstimate(adjacent) == DistanceField::Unreachable)
+				continue;
+
+			if (!CanScan())
+				return false;
+
+			if (IsAccessible(adjacent))
+				Remember(adjacent);
+		}
+
+		{
+			MAZESOLVER_TRACE_SCOPE("Route");
+
+			// Going on is pointless if the known walls enclose the runner
+			if (!IsExitReachable() || GetEstimate(CurrentPoint) == DistanceField::Unreachable)
+				return false;
+
+			if (!GetBestFirstRoute(CurrentPoint, route))
+				return false;
+		}
+
+		while (!route.IsEmpty())
+		{
+			if (!CanMove())
+				return false;
+
+			Move(route.Pop());
+		}
+	}
+}
+
+bool MazeSolver::Solver::GetBestFirstRoute(int initialPoint, Path& path)
+{
+	/*
+		let Q be a queue
+		let F be a path
+		let p be a point
+		let b be the best point
+
+		Q.Push(initial point)
+		do
+			p = Q.Pop()
+
+			if p is remembered
+				if b is found and p is further than the cost of b
+					break
+				if p can reach the exit and the cost of p is lower than the cost of b
+					b = p
+				continue
+
+			for w in M.AdjacentEdges(p)
+				if w is not visited and the edge to w is known to be open and w is discovered or remembered
+					w.Parent = p
+					label w as visited
+					Q.Push(w)
+		while Q is not empty
+
+		F = the parents of b up to the start
+	*/
+
+	PointQueue& queue = searchQueue;
+	queue.Clear();
+
+	ClearVisited();
+
+	// The distances are kept by the levels of the queue
+	unsigned int distance = 0;
+	unsigned int levelSize = 1;
+
+	Visit(initialPoint);
+	queue.Push(initialPoint);
+
+	int bestPoint = -1;
+	unsigned int bestCost = 0;
+	unsigned int bestEstimate = 0;
+
+	do
+	{
+		int point = queue.Pop();
+
+		if (IsRemembered(point))
+		{
+			// The estimate is never negative, so the further points cannot cost less
+			if (bestPoint != -1 && distance > bestCost)
+				break;
+
+			unsigned int estimate = GetEstimate(point);
+			if (estimate != DistanceField::Unreachable && !IsPruned(point))
+			{
+				// Of the points that cost the same, the one closer to the exit is taken
+				unsigned int cost = distance + estimate;
+				if (bestPoint == -1 || cost < bestCost || (cost == bestCost && estimate < bestEstimate))
+				{
+					bestPoint = point;
+					bestCost = cost;
+					bestEstimate = estimate;
+				}
+			}
+		}
+		else
+		{
+			// Every possible direction
+			for (unsigned int i = 0; i < Topology::Directions; i++)
+			{
+				int adjacent = GetAdjacent(i, point, false);
+				if (adjacent == -1 || IsVisited(adjacent) || !IsOpen(adjacent, point))
+					continue;
+
+				// The runner knows only the edges around the points it has been to
+				if (!IsDiscovered(adjacent) && !IsRemembered(adjacent))
+					continue;
+
+				SetPrevious(adjacent, point);
+				Visit(adjacent);
+				queue.Push(adjacent);
+			}
+		}
+
+		if (--levelSize == 0)
+		{
+			distance++;
+			levelSize = (unsigned int)queue.ToList().Size();
+		}
+	}
+	while (!queue.IsEmpty());
+
+	path.Clear(); // Initialize to an empty path
+
+	if (bestPoint == -1)
+		return false;
+
+	int point = bestPoint;
+	while (point != initialPoint)
+	{
+		path.Push(point);
+		point = GetPrevious(point);
+
+#if defined MAZESOLVER_TILED_STORAGE
+		// A tile that could not be mapped has no parents to follow
+		if (!cells.IsUsable())
+		{
+			path.Clear();
+			return false;
+		}
+#endif
+	}
+
+	return true;
+}
+
+unsigned int MazeSolver::Solver::GetEstimate(int point)
+{
+	// The field knows the walls found so far, the distance on the grid ignores them
+	if (distanceField != nullptr)
+		return distanceField->DistanceToGoal(point);
+
+	return Topology::GetDistance(point, EndPoint);
+}
\ No newline at end of file
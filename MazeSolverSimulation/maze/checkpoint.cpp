@@ -0,0 +1,184 @@
+#include "mazesolver.h"
+
+// Marks the saved states, the last byte is the version of the layout
+static const unsigned int StateMagic = 0x4D534301;
+
+static void Write(unsigned char*& cursor, const void* value, unsigned int size)
+{
+	const unsigned char* bytes = (const unsigned char*)value;
+	for (unsigned int i = 0; i < size; i++)
+		*cursor++ = bytes[i];
+}
+
+static void Read(const unsigned char*& cursor, void* value, unsigned int size)
+{
+	unsigned char* bytes = (unsigned char*)value;
+	for (unsigned int i = 0; i < size; i++)
+		bytes[i] = *cursor++;
+}
+
+#if defined MAZESOLVER_TILED_STORAGE
+// Packs a layer of the tiled storage in the order of the points or the edges, like the bitsets of the solver
+static void WriteLayer(unsigned char*& cursor, MazeSolver::TileStore& cells, MazeSolver::TileStore::Layer layer, unsigned int bits, unsigned int count)
+{
+	for (unsigned int i = 0; i < count; i += 8)
+	{
+		unsigned char byte = 0;
+		for (unsigned int bit = 0; bit < 8 && i + bit < count; bit++)
+		{
+			if ((cells.Get(layer, (i + bit) / bits) & (1 << ((i + bit) % bits))) != 0)
+				byte |= 1 << bit;
+		}
+
+		*cursor++ = byte;
+	}
+}
+
+static void ReadLayer(const unsigned char*& cursor, MazeSolver::TileStore& cells, MazeSolver::TileStore::Layer layer, unsigned int bits, unsigned int count)
+{
+	cells.Clear(layer);
+
+	for (unsigned int i = 0; i < count; i += 8)
+	{
+		unsigned char byte = *cursor++;
+		for (unsigned int bit = 0; bit < 8 && i + bit < count; bit++)
+		{
+			if ((byte & (1 << bit)) != 0)
+				cells.Set(layer, (i + bit) / bits, cells.Get(layer, (i + bit) / bits) | (1 << ((i + bit) % bits)));
+		}
+	}
+}
+#endif
+
+unsigned int MazeSolver::Solver::SaveState(unsigned char* buffer, unsigned int size)
+{
+	/*
+		The state is written in the byte order of the machine:
+
+		header       magic, width, height, edges, the current point, the solution, the heading
+		points       the discovered points, the remembered points
+		edges        the open edges, the walls
+		progress     the report, the result
+		memory       the number of the points remembered by the runner, the points
+	*/
+
+	unsigned int memorySize = (unsigned int)runnerMemory.Size();
+	unsigned int stateSize = StateSize - (Width * Height - memorySize) * sizeof(int);
+	if (size < stateSize)
+		return 0;
+
+	unsigned char* cursor = buffer;
+
+	unsigned int width = Width;
+	unsigned int height = Height;
+	unsigned int edges = Topology::Edges;
+	unsigned char solution = (unsigned char)activeSolution;
+	unsigned char direction = (unsigned char)heading;
+
+	Write(cursor, &StateMagic, sizeof(StateMagic));
+	Write(cursor, &width, sizeof(width));
+	Write(cursor, &height, sizeof(height));
+	Write(cursor, &edges, sizeof(edges));
+	Write(cursor, &CurrentPoint, sizeof(CurrentPoint));
+	Write(cursor, &solution, sizeof(solution));
+	Write(cursor, &direction, sizeof(direction));
+
+#if defined MAZESOLVER_TILED_STORAGE
+	WriteLayer(cursor, cells, TileStore::Layer::Discovered, 1, Width * Height);
+	WriteLayer(cursor, cells, TileStore::Layer::Remembered, 1, Width * Height);
+	WriteLayer(cursor, cells, TileStore::Layer::OpenEdges, 2, Topology::Edges);
+	WriteLayer(cursor, cells, TileStore::Layer::ClosedEdges, 2, Topology::Edges);
+#else
+	Write(cursor, discoveredPoints, sizeof(discoveredPoints));
+	Write(cursor, rememberedPoints, sizeof(rememberedPoints));
+	Write(cursor, openEdges, sizeof(openEdges));
+	Write(cursor, closedEdges, sizeof(closedEdges));
+#endif
+
+	Write(cursor, &report, sizeof(report));
+	Write(cursor, &result, sizeof(result));
+
+	Write(cursor, &memorySize, sizeof(memorySize));
+	for (int point : runnerMemory)
+		Write(cursor, &point, sizeof(point));
+
+#if defined MAZESOLVER_ASSERTS_ALLOWED
+	assert((unsigned int)(cursor - buffer) == stateSize);
+#endif
+
+	return stateSize;
+}
+
+bool MazeSolver::Solver::LoadState(const unsigned char* buffer, unsigned int size)
+{
+	const unsigned int fixedSize = StateSize - Width * Height * sizeof(int);
+	if (size < fixedSize)
+		return false;
+
+	const unsigned char* cursor = buffer;
+
+	unsigned int magic;
+	unsigned int width;
+	unsigned int height;
+	unsigned int edges;
+	int point;
+	unsigned char solution;
+	unsigned char direction;
+
+	Read(cursor, &magic, sizeof(magic));
+	Read(cursor, &width, sizeof(width));
+	Read(cursor, &height, sizeof(height));
+	Read(cursor, &edges, sizeof(edges));
+	Read(cursor, &point, sizeof(point));
+	Read(cursor, &solution, sizeof(solution));
+	Read(cursor, &direction, sizeof(direction));
+
+	// The state of another maze or another topology does not fit into this one
+	if (magic != StateMagic || width != Width || height != Height || edges != Topology::Edges)
+		return false;
+
+	if (point < 0 || point >= (int)(Width * Height) || solution > (unsigned char)Solution::WallFollower)
+		return false;
+
+	// The number of the remembered points is right after the fixed part
+	unsigned int memorySize;
+	const unsigned char* memoryCursor = buffer + fixedSize - sizeof(memorySize);
+	Read(memoryCursor, &memorySize, sizeof(memorySize));
+	if (memorySize > Width * Height || size < fixedSize + memorySize * sizeof(int))
+		return false;
+
+	CurrentPoint = point;
+	activeSolution = (Solution)solution;
+	heading = (Direction)direction;
+
+#if defined MAZESOLVER_TILED_STORAGE
+	ReadLayer(cursor, cells, TileStore::Layer::Discovered, 1, Width * Height);
+	ReadLayer(cursor, cells, TileStore::Layer::Remembered, 1, Width * Height);
+	ReadLayer(cursor, cells, TileStore::Layer::OpenEdges, 2, Topology::Edges);
+	ReadLayer(cursor, cells, TileStore::Layer::ClosedEdges, 2, Topology::Edges);
+#else
+	Read(cursor, discoveredPoints, sizeof(discoveredPoints));
+	Read(cursor, rememberedPoints, sizeof(rememberedPoints));
+	Read(cursor, openEdges, sizeof(openEdges));
+	Read(cursor, closedEdges, sizeof(closedEdges));
+#endif
+
+	Read(cursor, &report, sizeof(report));
+	Read(cursor, &result, sizeof(result));
+
+	cursor += sizeof(memorySize);
+
+	runnerMemory.Clear();
+	for (unsigned int i = 0; i < memorySize; i++)
+	{
+		Read(cursor, &point, sizeof(point));
+		if (point >= 0 && point < (int)(Width * Height))
+			runnerMemory.Push(point);
+	}
+
+	// The moves not sent before the state was saved are not the runner's anymore
+	runDirection = Direction::Invalid;
+	runLength = 0;
+
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "config.h"
+
+#if defined MAZESOLVER_ASYNC_MOTION
+
+#include <atomic>
+
+namespace MazeSolver
+{
+
+	// A ring buffer of a fixed capacity shared by a single producer thread and a single consumer thread,
+	// neither of them locks
+	template<typename T, unsigned int Capacity>
+	class CommandQueue
+	{
+		static_assert(Capacity != 0 && (Capacity & (Capacity - 1)) == 0, "The capacity has to be a power of two");
+
+	public:
+		/// <summary>
+		/// Constructor.
+		/// </summary>
+		CommandQueue()
+			: head(0), tail(0) {}
+
+		/// <summary>
+		/// Checks whether the queue is empty.
+		/// </summary>
+		/// <returns>True if empty, false otherwise.</returns>
+		bool IsEmpty()
+		{
+			return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+		}
+
+		/// <summary>
+		/// Checks whether the queue is full.
+		/// </summary>
+		/// <returns>True if full, false otherwise.</returns>
+		bool IsFull()
+		{
+			return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire) == Capacity;
+		}
+
+		/// <summary>
+		/// Push a value to the queue, called only by the producer.
+		/// </summary>
+		/// <param name="value">A value to push.</param>
+		/// <returns>False if the queue is full, true otherwise.</returns>
+		bool TryPush(const T& value)
+		{
+			unsigned int position = tail.load(std::memory_order_relaxed);
+			if (position - head.load(std::memory_order_acquire) == Capacity)
+				return false;
+
+			values[position % Capacity] = value;
+
+			// The value is written before the consumer can see it
+			tail.store(position + 1, std::memory_order_release);
+			return true;
+		}
+
+		/// <summary>
+		/// Pop a value from the queue, called only by the consumer.
+		/// </summary>
+		/// <param name="value">A place to store the value.</param>
+		/// <returns>False if the queue is empty, true otherwise.</returns>
+		bool TryPop(T& value)
+		{
+			unsigned int position = head.load(std::memory_order_relaxed);
+			if (position == tail.load(std::memory_order_acquire))
+				return false;
+
+			value = values[position % Capacity];
+
+			// The value is read before the producer can overwrite it
+			head.store(position + 1, std::memory_order_release);
+			return true;
+		}
+
+	private:
+		T values[Capacity];
+
+		// The positions only grow, they wrap around together with the unsigned arithmetic
+		std::atomic<unsigned int> head;
+		std::atomic<unsigned int> tail;
+
+	};
+
+}
+
+#endif
\ No newline at end of file
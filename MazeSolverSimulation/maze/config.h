@@ -0,0 +1,86 @@
+#pragma once
+
+// Uncomment this to enable asserts
+// #define MAZESOLVER_ASSERTS_ALLOWED
+
+// The dimensions of the maze, define these before including the solver to change them
+#if !defined MAZESOLVER_WIDTH
+#define MAZESOLVER_WIDTH 5
+#endif
+
+#if !defined MAZESOLVER_HEIGHT
+#define MAZESOLVER_HEIGHT 5
+#endif
+
+// Uncomment one of these to let the runner move diagonally or through a grid of hexagons,
+// only the breadth-first planner searches these grids
+// #define MAZESOLVER_OCTILE_TOPOLOGY
+// #define MAZESOLVER_HEX_TOPOLOGY
+
+// The number of searches remembered by a plan cache, raise it when many mazes are solved with a shared cache
+#if !defined MAZESOLVER_PLAN_CACHE_SIZE
+#define MAZESOLVER_PLAN_CACHE_SIZE 64
+#endif
+
+// The side of a square cluster used by the hierarchical planner
+#if !defined MAZESOLVER_CLUSTER_SIZE
+#define MAZESOLVER_CLUSTER_SIZE 8
+#endif
+
+// The number of 64-bit words of lanes of the batch planner, 4 words let the compiler use 256-bit registers
+#if !defined MAZESOLVER_BATCH_WORDS
+#define MAZESOLVER_BATCH_WORDS 1
+#endif
+
+// Uncomment this to keep the known points and edges and the search state in a memory-mapped file instead of the solver
+// #define MAZESOLVER_TILED_STORAGE
+
+// The side of a square tile of the tiled storage
+#if !defined MAZESOLVER_TILE_SIZE
+#define MAZESOLVER_TILE_SIZE 128
+#endif
+
+// The number of tiles of the tiled storage that are kept in the memory at once
+#if !defined MAZESOLVER_RESIDENT_TILES
+#define MAZESOLVER_RESIDENT_TILES 64
+#endif
+
+// Uncomment this to enable the hierarchical planner, its cluster graph takes many times the memory of the maze
+// #define MAZESOLVER_HIERARCHICAL_PLANNER
+
+// Uncomment this to enable the parallel planner, it requires the standard threads
+// #define MAZESOLVER_PARALLEL_PLANNER
+
+// The maximum number of threads used by the parallel planner
+#if !defined MAZESOLVER_PLANNER_THREADS
+#define MAZESOLVER_PLANNER_THREADS 8
+#endif
+
+// Uncomment this to send the moves to a thread of their own, the solver plans ahead while the runner drives,
+// it requires the standard threads and the movement functions are then called from that thread
+// #define MAZESOLVER_ASYNC_MOTION
+
+// The number of move commands that can wait for the runner, a power of two
+#if !defined MAZESOLVER_MOTION_QUEUE_SIZE
+#define MAZESOLVER_MOTION_QUEUE_SIZE 16
+#endif
+
+// Uncomment this to record a timeline of the solver phases, the scans and the moves,
+// it is written as a trace-event JSON file for Chrome or Perfetto
+// #define MAZESOLVER_TRACING
+
+// The number of traced events kept for each thread
+#if !defined MAZESOLVER_TRACE_EVENTS
+#define MAZESOLVER_TRACE_EVENTS 65536
+#endif
+
+// Uncomment this to use containers with a fixed capacity, solving then never allocates
+// #define MAZESOLVER_STATIC_CONTAINERS
+
+// Uncomment this to prune the dead ends found from the scanned walls, the searches and the runner skip them
+// #define MAZESOLVER_PRUNING
+
+// Uncomment this to leave the Tremaux marks out of the wall follower on the boards without memory for them,
+// they take 2 bits per edge. A wall follower that loops without them gives up with SolveStatus::GaveUp,
+// as it does not know whether the exit is reachable
+// #define MAZESOLVER_NO_TREMAUX_MARKS
\ No newline at end of file
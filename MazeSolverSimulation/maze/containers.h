@@ -0,0 +1,33 @@
+#pragma once
+
+#include "config.h"
+
+#include "list.h"
+#include "staticlist.h"
+#include "stack.h"
+#include "queue.h"
+#include "obstacle.h"
+#include "topology.h"
+
+namespace MazeSolver
+{
+
+#if defined MAZESOLVER_STATIC_CONTAINERS
+	// The sizes of the containers are bounded by the size of the maze, so they never allocate
+	using PointList = StaticList<int, MAZESOLVER_WIDTH * MAZESOLVER_HEIGHT>;
+	// A point is remembered by the runner at most once at a time
+	using CandidateList = StaticList<int, MAZESOLVER_WIDTH * MAZESOLVER_HEIGHT>;
+	// Every edge of the topology is walled at most once
+	using ObstacleList = StaticList<Obstacle, Topology::Edges>;
+#else
+	using PointList = List<int>;
+	using CandidateList = List<int>;
+	using ObstacleList = List<Obstacle>;
+#endif
+
+	// A path with the next point on top
+	using Path = Stack<int, PointList>;
+
+	using PointQueue = Queue<int, PointList>;
+
+}
\ No newline at end of file
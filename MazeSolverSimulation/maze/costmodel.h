@@ -0,0 +1,67 @@
+#pragma once
+
+namespace MazeSolver
+{
+
+	/// <summary>
+	/// A function type for the clock function with signature:
+	/// double Clock()
+	/// </summary>
+	/// <returns>The current time in milliseconds.</returns>
+	using ClockFunction = double (*)();
+
+	// The time that the actions of the runner take, all times are in milliseconds
+	struct CostModel
+	{
+		// The time of a single scan
+		double ScanCost = 0;
+
+		// The time of a move between adjacent points
+		double MoveCost = 0;
+
+		// The time of a quarter turn, turning around takes two
+		double TurnCost = 0;
+
+		// The longest time a single search for the path may take, 0 if not limited,
+		// a longer search switches the rest of the solve to the hierarchical planner when it is compiled
+		double PlanningBudget = 0;
+
+		// The clock used to measure the elapsed time, nothing is measured and no time limit can be set without it
+		ClockFunction Clock = nullptr;
+	};
+
+	// The actions taken by the last solve and the time they took
+	struct CostReport
+	{
+		unsigned int Scans = 0;
+		unsigned int Moves = 0;
+		unsigned int Turns = 0;
+
+		// The searches for the path, scanning less makes the runner find the walls later and search more often
+		unsigned int Plans = 0;
+
+		// The searches answered by the plan cache
+		unsigned int CachedPlans = 0;
+
+		// The measured time spent searching for the path
+		double PlanningTime = 0;
+
+		// Whether a search ran over the planning budget and the rest of the solve used the hierarchical planner
+		bool OverBudget = false;
+
+		// The searches done while the runner was moving, in case the next point of the path is behind a wall,
+		// and the ones of them used instead of searching after the wall was found
+		unsigned int ContingencyPlans = 0;
+		unsigned int ContingencyHits = 0;
+
+		// The measured time of those searches, the moves hide it so it is not predicted
+		double HiddenPlanningTime = 0;
+
+		// The time of the actions according to the cost model and the measured planning time
+		double PredictedTime = 0;
+
+		// The measured time of the whole solve
+		double ActualTime = 0;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,268 @@
+#include "distancefield.h"
+
+MazeSolver::DistanceField::DistanceField()
+	: walls()
+{
+	Clear();
+	AddGoal(Cells - 1);
+}
+
+void MazeSolver::DistanceField::Clear()
+{
+	for (unsigned int i = 0; i < sizeof(walls); i++)
+		walls[i] = 0;
+
+	for (unsigned int point = 0; point < Cells; point++)
+	{
+		distances[point] = Unreachable;
+		nextHops[point] = -1;
+
+		buckets[point] = -1;
+		bucketNext[point] = -1;
+		bucketPrevious[point] = NotQueued;
+	}
+
+	pendingCount = 0;
+}
+
+void MazeSolver::DistanceField::AddGoal(int point)
+{
+	/*
+		let Q be a queue
+
+		Q.Push(goal)
+		while Q is not empty
+			p = Q.Pop()
+			for w in M.AdjacentEdges(p)
+				if there is no wall between p and w and w is further than p.Distance + 1
+					w.Distance = p.Distance + 1
+					w.NextHop = p
+					Q.Push(w)
+	*/
+
+	if (distances[point] == 0)
+		return;
+
+	distances[point] = 0;
+	nextHops[point] = -1;
+
+	// The points are reached in the order of their distance to the new goal, so each is pushed once
+	unsigned int head = 0;
+	unsigned int tail = 0;
+	pending[tail++] = point;
+
+	while (head != tail)
+	{
+		int current = pending[head++];
+
+		for (unsigned int i = 0; i < Topology::Directions; i++)
+		{
+			int adjacent = Topology::GetAdjacent(Topology::GetDirection(i), current);
+			if (adjacent == -1 || IsWall(current, adjacent))
+				continue;
+
+			if (distances[adjacent] <= distances[current] + 1)
+				continue;
+
+			distances[adjacent] = distances[current] + 1;
+			nextHops[adjacent] = current;
+			pending[tail++] = adjacent;
+		}
+	}
+}
+
+void MazeSolver::DistanceField::AddWall(int first, int second)
+{
+	/*
+		let S be a list of the points that got further
+		let B be buckets of the points by their distance
+
+		for p in the points of the wall whose next hop is behind it
+			if p has no other adjacent point closer by one
+				S.Add(p)
+		for p in S
+			for w in the adjacent points whose next hop is p
+				if w has no other adjacent point closer by one
+					S.Add(w)
+
+		for p in S
+			p.Distance = the closest adjacent point not in S + 1
+			B.Add(p)
+		while B is not empty
+			p = B.PopClosest()
+			for w in M.AdjacentEdges(p)
+				if there is no wall between p and w and w is further than p.Distance + 1
+					w.Distance = p.Distance + 1
+					w.NextHop = p
+					B.Add(w)
+	*/
+
+	if (IsWall(first, second))
+		return;
+
+	unsigned int edge = Topology::GetEdge(first, second);
+	walls[edge / 8] |= 1 << (edge % 8);
+
+	pendingCount = 0;
+
+	// The other points keep their shortest paths
+	if (nextHops[first] == second)
+		Invalidate(first);
+	if (nextHops[second] == first)
+		Invalidate(second);
+
+	if (pendingCount == 0)
+		return;
+
+	// The points that went through an invalidated point are invalidated too, the list grows while it's read
+	for (unsigned int i = 0; i < pendingCount; i++)
+	{
+		int point = pending[i];
+
+		for (unsigned int j = 0; j < Topology::Directions; j++)
+		{
+			int adjacent = Topology::GetAdjacent(Topology::GetDirection(j), point);
+			if (adjacent != -1 && nextHops[adjacent] == point)
+				Invalidate(adjacent);
+		}
+	}
+
+	// The invalidated points are searched again from the points around them that kept their distance
+	unsigned int lowest = Unreachable;
+	unsigned int queued = 0;
+	for (unsigned int i = 0; i < pendingCount; i++)
+	{
+		int point = pending[i];
+
+		for (unsigned int j = 0; j < Topology::Directions; j++)
+		{
+			int adjacent = Topology::GetAdjacent(Topology::GetDirection(j), point);
+			if (adjacent == -1 || distances[adjacent] == Unreachable || IsWall(point, adjacent))
+				continue;
+
+			if (distances[adjacent] + 1 < distances[point])
+			{
+				distances[point] = distances[adjacent] + 1;
+				nextHops[point] = adjacent;
+			}
+		}
+
+		if (distances[point] == Unreachable)
+			continue;
+
+		Insert(point);
+		queued++;
+
+		if (distances[point] < lowest)
+			lowest = distances[point];
+	}
+
+	// The buckets are emptied in the order of the distance, a point is final when it's taken out
+	for (unsigned int distance = lowest; queued != 0; distance++)
+	{
+		while (buckets[distance] != -1)
+		{
+			int point = buckets[distance];
+			Remove(point);
+			queued--;
+
+			for (unsigned int i = 0; i < Topology::Directions; i++)
+			{
+				int adjacent = Topology::GetAdjacent(Topology::GetDirection(i), point);
+				if (adjacent == -1 || IsWall(point, adjacent))
+					continue;
+
+				if (distances[adjacent] <= distance + 1)
+					continue;
+
+				if (bucketPrevious[adjacent] != NotQueued)
+				{
+					Remove(adjacent);
+					queued--;
+				}
+
+				distances[adjacent] = distance + 1;
+				nextHops[adjacent] = point;
+
+				Insert(adjacent);
+				queued++;
+			}
+		}
+	}
+}
+
+bool MazeSolver::DistanceField::IsWall(int first, int second)
+{
+	unsigned int edge = Topology::GetEdge(first, second);
+	return (walls[edge / 8] & (1 << (edge % 8))) != 0;
+}
+
+unsigned int MazeSolver::DistanceField::DistanceToGoal(int point)
+{
+	return distances[point];
+}
+
+int MazeSolver::DistanceField::NextHop(int point)
+{
+	return nextHops[point];
+}
+
+void MazeSolver::DistanceField::Invalidate(int point)
+{
+	// Another adjacent point as close as the lost one keeps the distance
+	if (FindNextHop(point))
+		return;
+
+	distances[point] = Unreachable;
+	nextHops[point] = -1;
+	pending[pendingCount++] = point;
+}
+
+bool MazeSolver::DistanceField::FindNextHop(int point)
+{
+	unsigned int distance = distances[point];
+	if (distance == 0 || distance == Unreachable)
+		return distance == 0;
+
+	for (unsigned int i = 0; i < Topology::Directions; i++)
+	{
+		int adjacent = Topology::GetAdjacent(Topology::GetDirection(i), point);
+		if (adjacent == -1 || IsWall(point, adjacent))
+			continue;
+
+		if (distances[adjacent] == distance - 1)
+		{
+			nextHops[point] = adjacent;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void MazeSolver::DistanceField::Insert(int point)
+{
+	int& head = buckets[distances[point]];
+
+	bucketPrevious[point] = -1;
+	bucketNext[point] = head;
+
+	if (head != -1)
+		bucketPrevious[head] = point;
+
+	head = point;
+}
+
+void MazeSolver::DistanceField::Remove(int point)
+{
+	if (bucketPrevious[point] == -1)
+		buckets[distances[point]] = bucketNext[point];
+	else
+		bucketNext[bucketPrevious[point]] = bucketNext[point];
+
+	if (bucketNext[point] != -1)
+		bucketPrevious[bucketNext[point]] = bucketPrevious[point];
+
+	bucketPrevious[point] = NotQueued;
+	bucketNext[point] = -1;
+}
\ No newline at end of file
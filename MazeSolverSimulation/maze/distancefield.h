@@ -0,0 +1,99 @@
+#pragma once
+
+#include "config.h"
+
+#include "topology.h"
+
+namespace MazeSolver
+{
+
+	// The number of moves from every point to the closest goal, with every edge that is not known to be a wall treated as open.
+	// The field is searched backwards from the goals once and then repaired only where the new walls make the points further
+	class DistanceField
+	{
+
+	public:
+		// The dimensions of the maze
+		static const unsigned int Width = MAZESOLVER_WIDTH;
+		static const unsigned int Height = MAZESOLVER_HEIGHT;
+		static const unsigned int Cells = Width * Height;
+
+		// The distance of a point that cannot reach any goal
+		static const unsigned int Unreachable = 0xFFFFFFFF;
+
+	public:
+		/// <summary>
+		/// Constructor, the exit is the only goal.
+		/// </summary>
+		DistanceField();
+
+		/// <summary>
+		/// Forgets the walls and the goals, every point is then unreachable.
+		/// </summary>
+		void Clear();
+
+		/// <summary>
+		/// Adds a goal, the points closer to it than to the other goals get closer.
+		/// </summary>
+		/// <param name="point">The goal point.</param>
+		void AddGoal(int point);
+
+		/// <summary>
+		/// Adds a wall, the points whose shortest paths went through it get further.
+		/// </summary>
+		/// <param name="first">The first point.</param>
+		/// <param name="second">The second point.</param>
+		void AddWall(int first, int second);
+
+		/// <summary>
+		/// Checks whether there is a wall between two adjacent points.
+		/// </summary>
+		/// <param name="first">The first point.</param>
+		/// <param name="second">The second point.</param>
+		/// <returns>True if the wall is known, false otherwise.</returns>
+		bool IsWall(int first, int second);
+
+		/// <summary>
+		/// Gets the number of moves from a point to the closest goal.
+		/// </summary>
+		/// <param name="point">The point.</param>
+		/// <returns>The distance, unreachable if no goal can be reached.</returns>
+		unsigned int DistanceToGoal(int point);
+
+		/// <summary>
+		/// Gets the adjacent point to move to on a shortest path to the closest goal.
+		/// </summary>
+		/// <param name="point">The point.</param>
+		/// <returns>The next point, -1 if the point is a goal or no goal can be reached.</returns>
+		int NextHop(int point);
+
+	private:
+		// The previous point in the bucket of a point that is not waiting in one
+		static const int NotQueued = -2;
+
+	private:
+		void Invalidate(int point);
+		bool FindNextHop(int point);
+
+		void Insert(int point);
+		void Remove(int point);
+
+	private:
+		// The known walls, one bit per edge of the topology
+		unsigned char walls[(Topology::Edges + 7) / 8];
+
+		unsigned int distances[Cells];
+		int nextHops[Cells];
+
+		// The points whose distance is searched again, the same array is the queue of a new goal
+		int pending[Cells];
+		unsigned int pendingCount = 0;
+
+		// The points waiting for their distance in buckets by their distance, -1 ends a bucket
+		int buckets[Cells];
+		int bucketNext[Cells];
+		int bucketPrevious[Cells];
+
+	};
+
+}
\ No newline at end of file
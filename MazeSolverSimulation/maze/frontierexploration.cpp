@@ -0,0 +1,200 @@
+#include "mazesolver.h"
+
+bool MazeSolver::Solver::FrontierExplorationSolution()
+{
+	/*
+		let I be a runner
+		let M be a maze
+		let F be the frontier, the points found accessible but not discovered
+		let R be a path
+
+		repeat
+			if I detects the goal
+				end
+
+			label I.CurrentPoint as discovered
+			for w in M.AdjacentEdges(I.CurrentPoint)
+				if w is not discovered and the edge to w is not known and is accessible
+					F.Add(w)
+
+			R = shortest route along the known open edges to the closest points of F,
+				the one with the fewest unexplored points around it is taken
+			if R is not found
+				end
+			I.Go(R)
+	*/
+
+	// A resumed solve keeps the frontier of the saved one
+	if (!resuming)
+		ClearRemembered();
+
+	Path& route = runnerRoute;
+
+	while (true)
+	{
+		if (IsGoal())
+			return true;
+
+		Forget(CurrentPoint);
+		Discover(CurrentPoint);
+
+		// The points already in the frontier are scanned again from here, a shorter way to them saves the moves around
+		for (unsigned int i = 0; i < Topology::Directions; i++)
+		{
+			int adjacent = GetAdjacent(i);
+			if (adjacent == -1 || IsDiscovered(adjacent) || IsClosed(adjacent, CurrentPoint))
+				continue;
+
+			// Known to be open from a range scan, or already in the frontier
+			if (IsOpen(adjacent, CurrentPoint))
+			{
+				Remember(adjacent);
+				continue;
+			}
+
+			if (!CanScan())
+				return false;
+
+			if (IsAccessible(adjacent))
+				Remember(adjacent);
+		}
+
+		{
+			MAZESOLVER_TRACE_SCOPE("Route");
+
+			// Every point the runner can get to has been explored
+			if (!GetFrontierRoute(CurrentPoint, route))
+				return false;
+		}
+
+		while (!route.IsEmpty())
+		{
+			if (!CanMove())
+				return false;
+
+			Move(route.Pop());
+		}
+	}
+}
+
+bool MazeSolver::Solver::GetFrontierRoute(int initialPoint, Path& path)
+{
+	/*
+		let Q be a queue
+		let F be a path
+		let p be a point
+		let b be the best point
+
+		Q.Push(initial point)
+		do
+			p = Q.Pop()
+
+			if p is remembered
+				if b is found and p is further than b
+					break
+				if b is not found or p has fewer unexplored adjacent points than b
+					b = p
+				continue
+
+			for w in M.AdjacentEdges(p)
+				if w is not visited and the edge to w is known to be open and w is discovered or remembered
+					w.Parent = p
+					label w as visited
+					Q.Push(w)
+		while Q is not empty
+
+		F = the parents of b up to the start
+	*/
+
+	PointQueue& queue = searchQueue;
+	queue.Clear();
+
+	ClearVisited();
+
+	// The distances are kept by the levels of the queue
+	unsigned int distance = 0;
+	unsigned int levelSize = 1;
+
+	Visit(initialPoint);
+	queue.Push(initialPoint);
+
+	int bestPoint = -1;
+	unsigned int bestDistance = 0;
+	unsigned int bestUnexplored = 0;
+
+	do
+	{
+		int point = queue.Pop();
+
+		if (IsRemembered(point))
+		{
+			if (bestPoint != -1 && distance > bestDistance)
+				break;
+
+			// The point with the fewest unexplored points around it finishes its pocket before the runner leaves it,
+			// so that the runner does not have to come back for it later
+			unsigned int unexplored = 0;
+			for (unsigned int i = 0; i < Topology::Directions; i++)
+			{
+				int adjacent = GetAdjacent(i, point, false);
+				if (adjacent != -1 && !IsDiscovered(adjacent) && !IsRemembered(adjacent))
+					unexplored++;
+			}
+
+			if (bestPoint == -1 || unexplored < bestUnexplored)
+			{
+				bestPoint = point;
+				bestDistance = distance;
+				bestUnexplored = unexplored;
+			}
+		}
+		else
+		{
+			// Every possible direction
+			for (unsigned int i = 0; i < Topology::Directions; i++)
+			{
+				int adjacent = GetAdjacent(i, point, false);
+				if (adjacent == -1 || IsVisited(adjacent) || !IsOpen(adjacent, point))
+					continue;
+
+				// The runner knows only the edges around the points it has been to
+				if (!IsDiscovered(adjacent) && !IsRemembered(adjacent))
+					continue;
+
+				SetPrevious(adjacent, point);
+				Visit(adjacent);
+				queue.Push(adjacent);
+			}
+		}
+
+		if (--levelSize == 0)
+		{
+			distance++;
+			levelSize = (unsigned int)queue.ToList().Size();
+		}
+	}
+	while (!queue.IsEmpty());
+
+	path.Clear(); // Initialize to an empty path
+
+	if (bestPoint == -1)
+		return false;
+
+	int point = bestPoint;
+	while (point != initialPoint)
+	{
+		path.Push(point);
+		point = GetPrevious(point);
+
+#if defined MAZESOLVER_TILED_STORAGE
+		// A tile that could not be mapped has no parents to follow
+		if (!cells.IsUsable())
+		{
+			path.Clear();
+			return false;
+		}
+#endif
+	}
+
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,608 @@
+#include "hierarchicalplanner.h"
+
+#if defined MAZESOLVER_HIERARCHICAL_PLANNER
+
+MazeSolver::HierarchicalPlanner::HierarchicalPlanner()
+	: walls(), entrances(), entranceCount(), distances(), dirty(), openStamp(), closedStamp()
+{
+	Clear();
+}
+
+void MazeSolver::HierarchicalPlanner::AddObstacle(Obstacle obstacle)
+{
+	if (IsBlocked(obstacle.First, obstacle.Second))
+		return;
+
+	if (obstacle.Second - obstacle.First == 1)
+		walls[obstacle.First] |= WallRight;
+	else
+		walls[obstacle.First] |= WallUp;
+
+	// A wall across the border between two clusters changes the entrances of both,
+	// and so does a wall along the border, because it splits a run of entrances
+	int clusters[3] = { GetCluster(obstacle.First), GetCluster(obstacle.Second), -1 };
+	if (clusters[0] == clusters[1])
+	{
+		for (unsigned int side = 0; side < 4; side++)
+		{
+			if (IsOnSide(clusters[0], obstacle.First, side) && IsOnSide(clusters[0], obstacle.Second, side))
+				clusters[2] = GetNeighborCluster(clusters[0], side);
+		}
+	}
+
+	for (int cluster : clusters)
+	{
+		if (cluster == -1 || dirty[cluster])
+			continue;
+
+		dirty[cluster] = true;
+		dirtyClusters[dirtyCount++] = cluster;
+	}
+
+	if (!routeValid)
+		return;
+
+	// Only the remaining part of the path is affected
+	for (unsigned int i = routeIndex; i < routeLength; i++)
+	{
+		int cluster = GetCluster(route[i]);
+		if (cluster == clusters[0] || cluster == clusters[1] || cluster == clusters[2])
+		{
+			routeValid = false;
+			break;
+		}
+	}
+}
+
+void MazeSolver::HierarchicalPlanner::Clear()
+{
+	for (unsigned int i = 0; i < Width * Height; i++)
+		walls[i] = 0;
+
+	// Every cluster has to be built before the next search
+	dirtyCount = 0;
+	for (unsigned int i = 0; i < ClusterCount; i++)
+	{
+		dirty[i] = true;
+		dirtyClusters[dirtyCount++] = i;
+	}
+
+	routeValid = false;
+}
+
+bool MazeSolver::HierarchicalPlanner::GetPath(int initialPoint, int endPoint, Path& path)
+{
+	/*
+		let R be an abstract path
+		let F be a path
+
+		if R is not valid or does not start at the initial point
+			rebuild the clusters touched by new walls
+			R = shortest path between the entrances from the initial point to the exit
+			if R is not found
+				end
+		F = shortest path inside a cluster between the first two points of R
+		R.RemoveFirst()
+	*/
+
+	path.Clear(); // Initialize to an empty path
+
+	if (initialPoint == endPoint)
+		return true;
+
+	// Follow the previous abstract path if nothing on it has changed
+	if (routeValid && routeGoal == endPoint && routeIndex < routeLength && route[routeIndex] == initialPoint)
+	{
+		if (RefineSegment(path))
+			return true;
+	}
+
+	Rebuild();
+
+	if (!Search(initialPoint, endPoint))
+	{
+		routeValid = false;
+		return false;
+	}
+
+	return RefineSegment(path);
+}
+
+bool MazeSolver::HierarchicalPlanner::IsBlocked(int first, int second)
+{
+	if (first > second)
+	{
+		int temp = first;
+		first = second;
+		second = temp;
+	}
+
+	if (second - first == 1)
+		return (walls[first] & WallRight) != 0;
+
+	return (walls[first] & WallUp) != 0;
+}
+
+int MazeSolver::HierarchicalPlanner::GetCluster(int point)
+{
+	int x = point % Width;
+	int y = point / Width;
+
+	return (y / ClusterSize) * ClustersX + x / ClusterSize;
+}
+
+int MazeSolver::HierarchicalPlanner::GetNeighborCluster(int cluster, unsigned int side)
+{
+	int x = cluster % ClustersX;
+	int y = cluster / ClustersX;
+
+	switch (side)
+	{
+	case Side::Left:
+		return x > 0 ? cluster - 1 : -1;
+	case Side::Right:
+		return x + 1 < (int)ClustersX ? cluster + 1 : -1;
+	case Side::Down:
+		return y > 0 ? cluster - (int)ClustersX : -1;
+	case Side::Up:
+		return y + 1 < (int)ClustersY ? cluster + (int)ClustersX : -1;
+	}
+
+	// Code should never be able to get here
+	return -1;
+}
+
+bool MazeSolver::HierarchicalPlanner::IsOnSide(int cluster, int point, unsigned int side)
+{
+	int x = point % Width - (cluster % ClustersX) * ClusterSize;
+	int y = point / Width - (cluster / ClustersX) * ClusterSize;
+
+	switch (side)
+	{
+	case Side::Left:
+		return x == 0;
+	case Side::Right:
+		return x == ClusterSize - 1;
+	case Side::Down:
+		return y == 0;
+	case Side::Up:
+		return y == ClusterSize - 1;
+	}
+
+	// Code should never be able to get here
+	return false;
+}
+
+int MazeSolver::HierarchicalPlanner::GetLocal(int cluster, int point)
+{
+	int x = point % Width - (cluster % ClustersX) * ClusterSize;
+	int y = point / Width - (cluster / ClustersX) * ClusterSize;
+
+	return y * ClusterSize + x;
+}
+
+int MazeSolver::HierarchicalPlanner::GetNodePoint(int node)
+{
+	int cluster = node / NodesPerCluster;
+	int slot = node % NodesPerCluster;
+
+	return entrances[cluster][slot / EntrancesPerSide][slot % EntrancesPerSide];
+}
+
+void MazeSolver::HierarchicalPlanner::Rebuild()
+{
+	if (dirtyCount == 0)
+		return;
+
+	// The entrances of all dirty clusters have to be known before the distances are
+	for (unsigned int i = 0; i < dirtyCount; i++)
+	{
+		for (unsigned int side = 0; side < 4; side++)
+			BuildEntrances(dirtyClusters[i], side);
+	}
+
+	for (unsigned int i = 0; i < dirtyCount; i++)
+	{
+		int cluster = dirtyClusters[i];
+		for (unsigned int slot = 0; slot < NodesPerCluster; slot++)
+		{
+			if (slot % EntrancesPerSide >= entranceCount[cluster][slot / EntrancesPerSide])
+				continue;
+
+			SearchCluster(cluster, entrances[cluster][slot / EntrancesPerSide][slot % EntrancesPerSide]);
+
+			for (unsigned int other = 0; other < NodesPerCluster; other++)
+			{
+				if (other % EntrancesPerSide >= entranceCount[cluster][other / EntrancesPerSide])
+				{
+					distances[cluster][slot][other] = Unreachable;
+					continue;
+				}
+
+				int point = entrances[cluster][other / EntrancesPerSide][other % EntrancesPerSide];
+				distances[cluster][slot][other] = clusterDistance[GetLocal(cluster, point)];
+			}
+		}
+
+		dirty[cluster] = false;
+	}
+
+	dirtyCount = 0;
+}
+
+void MazeSolver::HierarchicalPlanner::BuildEntrances(int cluster, unsigned int side)
+{
+	entranceCount[cluster][side] = 0;
+
+	if (GetNeighborCluster(cluster, side) == -1)
+		return;
+
+	int left = (cluster % ClustersX) * ClusterSize;
+	int bottom = (cluster / ClustersX) * ClusterSize;
+	int right = left + ClusterSize < Width ? left + ClusterSize : Width;
+	int top = bottom + ClusterSize < Height ? bottom + ClusterSize : Height;
+
+	// The first point of the side, the step along it and the step across it
+	int first, along, across, length;
+	switch (side)
+	{
+	case Side::Left:
+		first = bottom * Width + left;
+		along = Width;
+		across = -1;
+		length = top - bottom;
+		break;
+	case Side::Right:
+		first = bottom * Width + right - 1;
+		along = Width;
+		across = 1;
+		length = top - bottom;
+		break;
+	case Side::Down:
+		first = bottom * Width + left;
+		along = 1;
+		across = -(int)Width;
+		length = right - left;
+		break;
+	default: // Up
+		first = (top - 1) * Width + left;
+		along = 1;
+		across = Width;
+		length = right - left;
+		break;
+	}
+
+	// Both clusters sharing a border walk it in the same order,
+	// so the entrance at some index on one side is paired with the same index on the other side.
+	// A run continues only while the points are connected along the border on both sides,
+	// so any point of the run can reach the entrance.
+	int runStart = -1;
+	for (int i = 0; i <= length; i++)
+	{
+		int point = first + i * along;
+		bool open = i < length && !IsBlocked(point, point + across);
+
+		if (runStart != -1 && (!open || IsBlocked(point - along, point) || IsBlocked(point - along + across, point + across)))
+		{
+			int middle = runStart + (i - 1 - runStart) / 2;
+			entrances[cluster][side][entranceCount[cluster][side]++] = first + middle * along;
+			runStart = -1;
+		}
+
+		if (open && runStart == -1)
+			runStart = i;
+	}
+}
+
+void MazeSolver::HierarchicalPlanner::SearchCluster(int cluster, int source)
+{
+	int left = (cluster % ClustersX) * ClusterSize;
+	int bottom = (cluster / ClustersX) * ClusterSize;
+	int right = left + ClusterSize < Width ? left + ClusterSize : Width;
+	int top = bottom + ClusterSize < Height ? bottom + ClusterSize : Height;
+
+	for (unsigned int i = 0; i < ClusterSize * ClusterSize; i++)
+		clusterDistance[i] = Unreachable;
+
+	unsigned int head = 0;
+	unsigned int tail = 0;
+
+	clusterDistance[GetLocal(cluster, source)] = 0;
+	clusterPrevious[GetLocal(cluster, source)] = source;
+	clusterQueue[tail++] = source;
+
+	while (head != tail)
+	{
+		int point = clusterQueue[head++];
+		int x = point % Width;
+		int y = point / Width;
+		unsigned short distance = clusterDistance[GetLocal(cluster, point)] + 1;
+
+		// 4 possible directions: Right -> Up -> Left -> Down
+		int adjacents[4] =
+		{
+			x + 1 < right ? point + 1 : -1,
+			y + 1 < top ? point + (int)Width : -1,
+			x > left ? point - 1 : -1,
+			y > bottom ? point - (int)Width : -1
+		};
+
+		for (int adjacent : adjacents)
+		{
+			if (adjacent == -1 || IsBlocked(point, adjacent))
+				continue;
+
+			int local = GetLocal(cluster, adjacent);
+			if (clusterDistance[local] != Unreachable)
+				continue;
+
+			clusterDistance[local] = distance;
+			clusterPrevious[local] = point;
+			clusterQueue[tail++] = adjacent;
+		}
+	}
+}
+
+bool MazeSolver::HierarchicalPlanner::Search(int initialPoint, int endPoint)
+{
+	/*
+		let G be a graph of the entrances with the distances inside the clusters
+		let S be the start point connected to the entrances of its cluster
+		let E be the exit point connected to the entrances of its cluster
+
+		R = A* from S to E over G with the Manhattan distance to E
+	*/
+
+	startCluster = GetCluster(initialPoint);
+	goalCluster = GetCluster(endPoint);
+
+	SearchCluster(goalCluster, endPoint);
+	for (unsigned int slot = 0; slot < NodesPerCluster; slot++)
+	{
+		if (slot % EntrancesPerSide >= entranceCount[goalCluster][slot / EntrancesPerSide])
+			continue;
+
+		goalDistance[slot] = clusterDistance[GetLocal(goalCluster, entrances[goalCluster][slot / EntrancesPerSide][slot % EntrancesPerSide])];
+	}
+
+	SearchCluster(startCluster, initialPoint);
+	for (unsigned int slot = 0; slot < NodesPerCluster; slot++)
+	{
+		if (slot % EntrancesPerSide >= entranceCount[startCluster][slot / EntrancesPerSide])
+			continue;
+
+		startDistance[slot] = clusterDistance[GetLocal(startCluster, entrances[startCluster][slot / EntrancesPerSide][slot % EntrancesPerSide])];
+	}
+
+	directDistance = Unreachable;
+	if (startCluster == goalCluster)
+		directDistance = clusterDistance[GetLocal(startCluster, endPoint)];
+
+	// Invalidate the previous search
+	stamp++;
+	heapSize = 0;
+
+	cost[StartNode] = 0;
+	priority[StartNode] = 0;
+	parent[StartNode] = -1;
+	openStamp[StartNode] = stamp;
+	HeapPush(StartNode);
+
+	bool found = false;
+	while (heapSize != 0)
+	{
+		int node = HeapPop();
+		closedStamp[node] = stamp;
+
+		if (node == GoalNode)
+		{
+			found = true;
+			break;
+		}
+
+		if (node == StartNode)
+		{
+			for (unsigned int slot = 0; slot < NodesPerCluster; slot++)
+			{
+				if (slot % EntrancesPerSide >= entranceCount[startCluster][slot / EntrancesPerSide] || startDistance[slot] == Unreachable)
+					continue;
+
+				Relax(node, startCluster * NodesPerCluster + slot, startDistance[slot], endPoint);
+			}
+
+			if (directDistance != Unreachable)
+				Relax(node, GoalNode, directDistance, endPoint);
+
+			continue;
+		}
+
+		int cluster = node / NodesPerCluster;
+		unsigned int slot = node % NodesPerCluster;
+
+		// Inside the cluster
+		for (unsigned int other = 0; other < NodesPerCluster; other++)
+		{
+			if (other == slot || distances[cluster][slot][other] == Unreachable)
+				continue;
+
+			Relax(node, cluster * NodesPerCluster + other, distances[cluster][slot][other], endPoint);
+		}
+
+		// Across the border
+		unsigned int side = slot / EntrancesPerSide;
+		int neighbor = GetNeighborCluster(cluster, side);
+		unsigned int opposite = side ^ 1;
+		Relax(node, neighbor * NodesPerCluster + opposite * EntrancesPerSide + slot % EntrancesPerSide, 1, endPoint);
+
+		if (cluster == goalCluster && goalDistance[slot] != Unreachable)
+			Relax(node, GoalNode, goalDistance[slot], endPoint);
+	}
+
+	if (!found)
+		return false;
+
+	// Store the abstract path from the start to the exit
+	routeLength = 0;
+	for (int node = GoalNode; node != -1; node = parent[node])
+		routeLength++;
+
+	unsigned int index = routeLength;
+	for (int node = GoalNode; node != -1; node = parent[node])
+	{
+		index--;
+		if (node == StartNode)
+			route[index] = initialPoint;
+		else if (node == GoalNode)
+			route[index] = endPoint;
+		else
+			route[index] = GetNodePoint(node);
+	}
+
+	routeIndex = 0;
+	routeGoal = endPoint;
+	routeValid = true;
+
+	return true;
+}
+
+void MazeSolver::HierarchicalPlanner::Relax(int node, int next, unsigned int edgeCost, int endPoint)
+{
+	if (closedStamp[next] == stamp)
+		return;
+
+	unsigned int nextCost = cost[node] + edgeCost;
+	bool open = openStamp[next] == stamp;
+	if (open && nextCost >= cost[next])
+		return;
+
+	int point = next == GoalNode ? endPoint : GetNodePoint(next);
+	int dx = point % Width - endPoint % Width;
+	int dy = point / Width - endPoint / Width;
+
+	cost[next] = nextCost;
+	priority[next] = nextCost + (dx < 0 ? -dx : dx) + (dy < 0 ? -dy : dy);
+	parent[next] = node;
+
+	if (open)
+	{
+		HeapUpdate(next);
+	}
+	else
+	{
+		openStamp[next] = stamp;
+		HeapPush(next);
+	}
+}
+
+bool MazeSolver::HierarchicalPlanner::RefineSegment(Path& path)
+{
+	// Skip the segments of zero length (an entrance shared by two sides of a cluster)
+	while (routeIndex + 1 < routeLength && route[routeIndex] == route[routeIndex + 1])
+		routeIndex++;
+
+	if (routeIndex + 1 >= routeLength)
+	{
+		routeValid = false;
+		return false;
+	}
+
+	int from = route[routeIndex];
+	int to = route[routeIndex + 1];
+
+	int cluster = GetCluster(from);
+	if (cluster != GetCluster(to)) // Crossing the border
+	{
+		path.Push(to);
+		routeIndex++;
+		return true;
+	}
+
+	SearchCluster(cluster, from);
+	if (clusterDistance[GetLocal(cluster, to)] == Unreachable)
+	{
+		routeValid = false;
+		return false;
+	}
+
+	int point = to;
+	while (point != from)
+	{
+		path.Push(point);
+		point = clusterPrevious[GetLocal(cluster, point)];
+	}
+
+	routeIndex++;
+	return true;
+}
+
+void MazeSolver::HierarchicalPlanner::HeapPush(int node)
+{
+	heap[heapSize] = node;
+	heapPosition[node] = heapSize;
+	heapSize++;
+
+	HeapUpdate(node);
+}
+
+void MazeSolver::HierarchicalPlanner::HeapUpdate(int node)
+{
+	// The priority of a node can only decrease, so it only moves up
+	unsigned int position = heapPosition[node];
+	while (position != 0)
+	{
+		unsigned int up = (position - 1) / 2;
+		if (priority[heap[up]] <= priority[heap[position]])
+			break;
+
+		HeapSwap(position, up);
+		position = up;
+	}
+}
+
+int MazeSolver::HierarchicalPlanner::HeapPop()
+{
+#if defined MAZESOLVER_ASSERTS_ALLOWED
+	assert(heapSize != 0);
+#endif
+
+	int node = heap[0];
+	heapSize--;
+
+	if (heapSize != 0)
+	{
+		HeapSwap(0, heapSize);
+
+		unsigned int position = 0;
+		while (true)
+		{
+			unsigned int smallest = position;
+			unsigned int left = position * 2 + 1;
+			unsigned int right = left + 1;
+
+			if (left < heapSize && priority[heap[left]] < priority[heap[smallest]])
+				smallest = left;
+			if (right < heapSize && priority[heap[right]] < priority[heap[smallest]])
+				smallest = right;
+
+			if (smallest == position)
+				break;
+
+			HeapSwap(position, smallest);
+			position = smallest;
+		}
+	}
+
+	return node;
+}
+
+void MazeSolver::HierarchicalPlanner::HeapSwap(int first, int second)
+{
+	int node = heap[first];
+	heap[first] = heap[second];
+	heap[second] = node;
+
+	heapPosition[heap[first]] = first;
+	heapPosition[heap[second]] = second;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "config.h"
+
+#if defined MAZESOLVER_HIERARCHICAL_PLANNER
+
+#if defined MAZESOLVER_ASSERTS_ALLOWED
+#include <cassert>
+#endif
+
+#include "containers.h"
+#include "obstacle.h"
+
+namespace MazeSolver
+{
+
+	// Hierarchical path planner (HPA*) for large mazes
+	class HierarchicalPlanner
+	{
+
+	public:
+		// The dimensions of the maze
+		static const unsigned int Width = MAZESOLVER_WIDTH;
+		static const unsigned int Height = MAZESOLVER_HEIGHT;
+
+		// The maze is partitioned into square clusters
+		static const unsigned int ClusterSize = MAZESOLVER_CLUSTER_SIZE;
+		static const unsigned int ClustersX = (Width + ClusterSize - 1) / ClusterSize;
+		static const unsigned int ClustersY = (Height + ClusterSize - 1) / ClusterSize;
+		static const unsigned int ClusterCount = ClustersX * ClustersY;
+
+		// An entrance is placed in the middle of every run of open edges along a side
+		static const unsigned int EntrancesPerSide = ClusterSize;
+		static const unsigned int NodesPerCluster = 4 * EntrancesPerSide;
+		static const unsigned int NodeCount = ClusterCount * NodesPerCluster;
+
+	public:
+		/// <summary>
+		/// Constructor.
+		/// </summary>
+		HierarchicalPlanner();
+
+		/// <summary>
+		/// Adds a wall to the map, only the clusters touched by the wall are invalidated.
+		/// </summary>
+		/// <param name="obstacle">The wall between two adjacent points.</param>
+		void AddObstacle(Obstacle obstacle);
+
+		/// <summary>
+		/// Removes every wall from the map, every cluster is rebuilt before the next search.
+		/// </summary>
+		void Clear();
+
+		/// <summary>
+		/// Searches for a path to the exit and refines the next segment of it.
+		/// The abstract path is kept between the calls, so that consecutive calls refine it segment by segment.
+		/// </summary>
+		/// <param name="initialPoint">The starting point.</param>
+		/// <param name="endPoint">The exit point.</param>
+		/// <param name="path">A place to store the next segment of the path.</param>
+		/// <returns>True if the exit is reachable, false otherwise.</returns>
+		bool GetPath(int initialPoint, int endPoint, Path& path);
+
+	private:
+		enum Side : unsigned char
+		{
+			Left,
+			Right,
+			Down,
+			Up
+		};
+
+		// Bits of the wall map, each point stores the walls on its upper and right edges
+		static const unsigned char WallUp = 1;
+		static const unsigned char WallRight = 2;
+
+		static const unsigned short Unreachable = 0xFFFF;
+
+		static const int StartNode = NodeCount;
+		static const int GoalNode = NodeCount + 1;
+
+	private:
+		bool IsBlocked(int first, int second);
+
+		int GetCluster(int point);
+		int GetNeighborCluster(int cluster, unsigned int side);
+		bool IsOnSide(int cluster, int point, unsigned int side);
+		int GetLocal(int cluster, int point);
+		int GetNodePoint(int node);
+
+		void Rebuild();
+		void BuildEntrances(int cluster, unsigned int side);
+		void SearchCluster(int cluster, int source);
+
+		bool Search(int initialPoint, int endPoint);
+		void Relax(int node, int next, unsigned int edgeCost, int endPoint);
+		bool RefineSegment(Path& path);
+
+		void HeapPush(int node);
+		void HeapUpdate(int node);
+		int HeapPop();
+		void HeapSwap(int first, int second);
+
+	private:
+		// The known walls
+		unsigned char walls[Width * Height];
+
+		// The entrances of each cluster side (points inside the cluster)
+		int entrances[ClusterCount][4][EntrancesPerSide];
+		unsigned char entranceCount[ClusterCount][4];
+
+		// The distances between the entrances of each cluster
+		unsigned short distances[ClusterCount][NodesPerCluster][NodesPerCluster];
+
+		// The clusters that have to be rebuilt before the next search
+		bool dirty[ClusterCount];
+		int dirtyClusters[ClusterCount];
+		unsigned int dirtyCount = 0;
+
+		// Scratch space of the search inside a single cluster
+		unsigned short clusterDistance[ClusterSize * ClusterSize];
+		int clusterPrevious[ClusterSize * ClusterSize];
+		int clusterQueue[ClusterSize * ClusterSize];
+
+		// Temporary edges of the start and the exit points
+		unsigned short startDistance[NodesPerCluster];
+		unsigned short goalDistance[NodesPerCluster];
+		unsigned short directDistance = Unreachable;
+		int startCluster = 0;
+		int goalCluster = 0;
+
+		// The state of the abstract search, a node is valid only if stamped by the current search
+		unsigned int cost[NodeCount + 2];
+		unsigned int priority[NodeCount + 2];
+		int parent[NodeCount + 2];
+		unsigned int openStamp[NodeCount + 2];
+		unsigned int closedStamp[NodeCount + 2];
+		unsigned int stamp = 0;
+
+		int heap[NodeCount + 2];
+		int heapPosition[NodeCount + 2];
+		unsigned int heapSize = 0;
+
+		// The abstract path as a list of points, refined lazily
+		int route[NodeCount + 2];
+		unsigned int routeLength = 0;
+		unsigned int routeIndex = 0;
+		int routeGoal = -1;
+		bool routeValid = false;
+
+	};
+
+}
+
+#endif
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "config.h"
+
 #if defined MAZESOLVER_ASSERTS_ALLOWED
 #include <cassert>
 #endif
@@ -148,14 +150,23 @@ namespace MazeSolver
 			return size == 0;
 		}
 
+		/// <summary>
+		/// Removes all values from the list, the capacity is kept.
+		/// </summary>
+		void Clear()
+		{
+			size = 0;
+		}
+
 		/// <summary>
 		/// Push a value to the list.
 		/// </summary>
 		/// <param name="value">A value to push.</param>
 		void Push(T value)
 		{
+			// Grow geometrically, so that pushing is amortized constant
 			if (size == capacity)
-				Resize(capacity + grow);
+				Resize(capacity * 2);
 
 			array[size++] = value;
 		}
@@ -1,31 +1,381 @@
 #include "mazesolver.h"
 
 MazeSolver::Solver::Solver(ScanFunction scanFunction, MovementFunction moveFunction)
-	: discoveredPoints()
+#if !defined MAZESOLVER_TILED_STORAGE
+	: discoveredPoints(), rememberedPoints(), visitedStamps(), previous(), openEdges(), closedEdges()
+#endif
 {
 	this->scanFunction = scanFunction;
 	this->moveFunction = moveFunction;
+
+#if defined MAZESOLVER_ASYNC_MOTION
+	actuator.SetFunctions(moveFunction, moveRunFunction);
+#endif
+
+#if defined MAZESOLVER_TILED_STORAGE
+	// A store that could not be opened stops every solve with the storage failed
+	cells.Open(nullptr);
+#endif
+}
+
+MazeSolver::SolveResult MazeSolver::Solver::Solve(Solution solution)
+{
+	report = CostReport();
+	result = SolveResult();
+
+	// The runner is placed again for a new solve, its first move is not a turn
+	heading = Direction::Invalid;
+
+	// The points explored by the last solve are not known to this one
+	ClearDiscovered();
+	ClearEdges();
+
+	// The planners keep their own copies of the walls
+#if defined MAZESOLVER_HIERARCHICAL_PLANNER
+	hierarchicalPlanner.Clear();
+#endif
+#if defined MAZESOLVER_PARALLEL_PLANNER
+	parallelPlanner.Clear();
+#endif
+
+	result.ClosestPoint = CurrentPoint;
+	result.ClosestDistance = Width + Height;
+	Explore(CurrentPoint);
+
+#if defined MAZESOLVER_PRUNING
+	pruner.Reset(CurrentPoint, EndPoint);
+#endif
+
+	activeSolution = solution;
+	activePlanner = planner;
+	resuming = false;
+
+	return Execute();
 }
 
-bool MazeSolver::Solver::Solve(Solution solution)
+MazeSolver::SolveResult MazeSolver::Solver::Resume()
 {
-	switch (solution)
+	// The status of the saved solve is decided again
+	result.Status = SolveStatus::Unreachable;
+
+	// The walls of the saved solve are memorized again by the solution
+#if defined MAZESOLVER_HIERARCHICAL_PLANNER
+	hierarchicalPlanner.Clear();
+#endif
+#if defined MAZESOLVER_PARALLEL_PLANNER
+	parallelPlanner.Clear();
+#endif
+
+#if defined MAZESOLVER_PRUNING
+	pruner.Reset(CurrentPoint, EndPoint);
+#endif
+
+	// The walls that are not saved with the state are found again from the known ones
+	for (int point = 0; point < (int)(Width * Height); point++)
+	{
+		for (unsigned int i = 0; i < Topology::Directions; i++)
+		{
+			int adjacent = GetAdjacent(i, point, false);
+			if (adjacent < point || !IsClosed(adjacent, point))
+				continue;
+
+#if defined MAZESOLVER_PRUNING
+			pruner.AddWall(point, adjacent);
+#endif
+
+			if (distanceField != nullptr)
+				distanceField->AddWall(point, adjacent);
+		}
+	}
+
+	activePlanner = planner;
+	resuming = true;
+
+	return Execute();
+}
+
+MazeSolver::SolveResult MazeSolver::Solver::Execute()
+{
+	MAZESOLVER_TRACE_SCOPE("Solve");
+
+	solveStartTime = GetTime();
+
+#if defined MAZESOLVER_TILED_STORAGE
+	// Nothing is known without the storage, so the solution is not started
+	if (!cells.IsUsable())
+	{
+		result.Status = SolveStatus::StorageFailed;
+		resuming = false;
+		return result;
+	}
+#endif
+
+	bool solved = false;
+	switch (activeSolution)
 	{
 	case Solution::AlgorithmicRunner:
-		return AlgorithmicRunnerSolution();
+		solved = AlgorithmicRunnerSolution();
+		break;
 	case Solution::PeriodicCorrection:
-		return PeriodicCorrectionSolution();
+		solved = PeriodicCorrectionSolution();
+		break;
+	case Solution::FrontierExploration:
+		solved = FrontierExplorationSolution();
+		break;
+	case Solution::BestFirstRunner:
+		solved = BestFirstRunnerSolution();
+		break;
+	case Solution::WallFollower:
+		solved = WallFollowerSolution();
+		break;
 #if defined MAZESOLVER_ASSERTS_ALLOWED
 	default:
 		assert(false); // Tried to solve using a not implemented solution
 #endif
 	}
 
-	// Code should never be able to get here
+	// The runner has to get to where the solution left it
+	SendRun();
+	WaitForMotion();
+
+	// A resumed solve adds to the time of the saved one
+	report.ActualTime += GetTime() - solveStartTime;
+	report.PredictedTime = report.Scans * costModel.ScanCost + report.Moves * costModel.MoveCost +
+		report.Turns * costModel.TurnCost + report.PlanningTime;
+
+	// A stopped solve has its status set already
+	if (solved)
+		result.Status = SolveStatus::Solved;
+#if defined MAZESOLVER_TILED_STORAGE
+	else if (!cells.IsUsable())
+		result.Status = SolveStatus::StorageFailed;
+#endif
+
+	resuming = false;
+
+	return result;
+}
+
+void MazeSolver::Solver::SetPlanner(Planner planner)
+{
+	this->planner = planner;
+	activePlanner = planner;
+}
+
+void MazeSolver::Solver::SetPlanCache(PlanCache* planCache)
+{
+	this->planCache = planCache;
+}
+
+void MazeSolver::Solver::SetDistanceField(DistanceField* distanceField)
+{
+	this->distanceField = distanceField;
+}
+
+void MazeSolver::Solver::SetScanPolicy(ScanPolicy scanPolicy)
+{
+	this->scanPolicy = scanPolicy;
+}
+
+void MazeSolver::Solver::SetMoveRunFunction(MoveRunFunction moveRunFunction)
+{
+	this->moveRunFunction = moveRunFunction;
+
+#if defined MAZESOLVER_ASYNC_MOTION
+	actuator.SetFunctions(moveFunction, moveRunFunction);
+#endif
+}
+
+void MazeSolver::Solver::SetRangeScanFunction(RangeScanFunction rangeScanFunction)
+{
+	this->rangeScanFunction = rangeScanFunction;
+}
+
+void MazeSolver::Solver::SetGoalFunction(GoalFunction goalFunction)
+{
+	this->goalFunction = goalFunction;
+}
+
+void MazeSolver::Solver::SetCostModel(const CostModel& costModel)
+{
+	this->costModel = costModel;
+}
+
+bool MazeSolver::Solver::SetLimits(const Limits& limits)
+{
+	// The time limit could never be reached without the clock
+	if (limits.MaxTime > 0 && costModel.Clock == nullptr)
+		return false;
+
+	this->limits = limits;
+	return true;
+}
+
+#if defined MAZESOLVER_TILED_STORAGE
+bool MazeSolver::Solver::SetTileFile(const char* path)
+{
+	return cells.Open(path);
+}
+#endif
+
+const MazeSolver::CostReport& MazeSolver::Solver::GetReport()
+{
+	return report;
+}
+
+bool MazeSolver::Solver::Plan(int initialPoint, ObstacleList& obstacles, Path& path)
+{
+	MAZESOLVER_TRACE_SCOPE("Plan");
+
+	double startTime = GetTime();
+
+	// The other planners search only the square grid
+	Planner selectedPlanner = Topology::Directions == 4 ? activePlanner : Planner::BreadthFirst;
+
+#if !defined MAZESOLVER_HIERARCHICAL_PLANNER
+	// The hierarchical planner is not compiled, the full search is done instead
+	if (selectedPlanner == Planner::Hierarchical)
+		selectedPlanner = Planner::BreadthFirst;
+#endif
+
+	// The hierarchical planner keeps the state of its segments, so only the full searches are remembered
+	bool cacheable = planCache != nullptr && selectedPlanner != Planner::Hierarchical;
+
+	bool found = false;
+	if (cacheable && planCache->Find(initialPoint, EndPoint, wallHash, found, path))
+	{
+		report.CachedPlans++;
+	}
+	else
+	{
+		switch (selectedPlanner)
+		{
+#if defined MAZESOLVER_HIERARCHICAL_PLANNER
+		case Planner::Hierarchical:
+			found = hierarchicalPlanner.GetPath(initialPoint, EndPoint, path);
+			break;
+#endif
+#if defined MAZESOLVER_PARALLEL_PLANNER
+		case Planner::Parallel:
+			found = parallelPlanner.GetShortestPath(initialPoint, EndPoint, path);
+			break;
+#else
+		case Planner::Parallel: // The parallel planner is not compiled, it finds the same path as BFS anyway
+#endif
+#if !defined MAZESOLVER_HIERARCHICAL_PLANNER
+		case Planner::Hierarchical: // The hierarchical planner is not compiled, it is replaced by BFS above
+#endif
+		case Planner::BreadthFirst:
+			found = GetShortestPath(initialPoint, obstacles, path);
+			break;
+#if defined MAZESOLVER_ASSERTS_ALLOWED
+		default:
+			assert(false); // Tried to plan using a not implemented planner
+#endif
+		}
+
+		if (cacheable)
+			planCache->Add(initialPoint, EndPoint, wallHash, found, path);
+	}
+
+	double planningTime = GetTime() - startTime;
+	report.PlanningTime += planningTime;
+	report.Plans++;
+
+#if defined MAZESOLVER_HIERARCHICAL_PLANNER
+	// A full search that does not fit into the budget is replaced by the hierarchical one,
+	// which only refines the next segment of the path, until the end of the solve
+	if (costModel.PlanningBudget > 0 && planningTime > costModel.PlanningBudget && selectedPlanner != Planner::Hierarchical)
+	{
+		activePlanner = Planner::Hierarchical;
+		report.OverBudget = true;
+	}
+#endif
+
+	return found;
+}
+
+void MazeSolver::Solver::Memorize(ObstacleList& obstacles, Obstacle obstacle)
+{
+	obstacles.Push(obstacle);
+
+	// Every wall is memorized once, so the hash never removes one by adding it again
+	wallHash ^= PlanCache::GetWallKey(Topology::GetEdge(obstacle.First, obstacle.Second));
+
+	if (Topology::Directions != 4)
+		return;
+
+#if defined MAZESOLVER_HIERARCHICAL_PLANNER
+	hierarchicalPlanner.AddObstacle(obstacle);
+#endif
+#if defined MAZESOLVER_PARALLEL_PLANNER
+	parallelPlanner.AddObstacle(obstacle);
+#endif
+}
+
+bool MazeSolver::Solver::IsBlockedAhead(Path& path)
+{
+	// Any two points next to each other in the path are adjacent
+	int previousPoint = -1;
+	for (int point : path.ToList())
+	{
+		if (previousPoint != -1 && IsClosed(point, previousPoint))
+			return true;
+
+		previousPoint = point;
+	}
+
 	return false;
 }
 
-bool MazeSolver::Solver::GetShortestPath(int initialPoint, List<Obstacle>& obstacles, Stack<int> &path)
+bool MazeSolver::Solver::PlanContingency(ObstacleList& obstacles, int nextPoint, Path& path)
+{
+#if defined MAZESOLVER_ASYNC_MOTION
+#if defined MAZESOLVER_HIERARCHICAL_PLANNER
+	// Only the full search can be repeated with a wall that is not known yet
+	if (Topology::Directions == 4 && activePlanner == Planner::Hierarchical)
+		return false;
+#endif
+
+	// A known path is not scanned again, so it is never found blocked
+	if (IsOpen(nextPoint, CurrentPoint))
+		return false;
+
+	// The runner drives to the current point during the search
+	SendRun();
+
+	MAZESOLVER_TRACE_SCOPE("Contingency plan");
+
+	double startTime = GetTime();
+
+	// The wall is assumed only for this search, the cache tells it apart by its hash
+	unsigned long long contingencyHash = wallHash ^ PlanCache::GetWallKey(Topology::GetEdge(nextPoint, CurrentPoint));
+
+	bool found = false;
+	if (planCache == nullptr || !planCache->Find(CurrentPoint, EndPoint, contingencyHash, found, path))
+	{
+		obstacles.Push(Obstacle(nextPoint, CurrentPoint));
+		found = GetShortestPath(CurrentPoint, obstacles, path);
+		obstacles.Pop();
+
+		if (planCache != nullptr)
+			planCache->Add(CurrentPoint, EndPoint, contingencyHash, found, path);
+	}
+
+	report.HiddenPlanningTime += GetTime() - startTime;
+	report.ContingencyPlans++;
+
+	return found;
+#else
+	(void)obstacles;
+	(void)nextPoint;
+	(void)path;
+
+	return false;
+#endif
+}
+
+bool MazeSolver::Solver::GetShortestPath(int initialPoint, ObstacleList& obstacles, Path& path)
 {
 	/*
 		let M be a maze
@@ -53,13 +403,25 @@ bool MazeSolver::Solver::GetShortestPath(int initialPoint, List<Obstacle>& obsta
 		while Q is not empty
 	*/
 
-	// The parent point for each point
-	int previous[Width * Height] = { 0 }; // Initialized to zero
-	Queue<int> queue;
+	MAZESOLVER_TRACE_SCOPE("GetShortestPath");
 
-	ClearDiscovered();
+	// The path from the exit is empty, the exit has no previous point to rebuild it from
+	if (initialPoint == EndPoint)
+	{
+		path.Clear();
+		return true;
+	}
+
+	PointQueue& queue = searchQueue;
+	queue.Clear();
 
-	Discover(initialPoint);
+	// The pruned points are known to be off every path from the runner,
+	// unless the runner has backtracked into them
+	bool prune = initialPoint == CurrentPoint && !IsPruned(initialPoint);
+
+	ClearVisited();
+
+	Visit(initialPoint);
 	queue.Push(initialPoint);
 
 	int point = queue.Peek();
@@ -71,12 +433,41 @@ bool MazeSolver::Solver::GetShortestPath(int initialPoint, List<Obstacle>& obsta
 		if (point == EndPoint)
 			break;
 
-		// 4 possible directions
-		for (unsigned int i = 0; i < 4; i++)
+#if defined MAZESOLVER_TILED_STORAGE
+		// The points of a tile that could not be mapped are never visited, so the search would not end
+		if (!cells.IsUsable())
+		{
+			path.Clear();
+			return false;
+		}
+#endif
+
+		// When turning is expensive, the point straight ahead is searched first,
+		// so that the path prefers straight runs among the equally short ones
+		Direction straight = Direction::Invalid;
+		if (costModel.TurnCost > 0 && point != initialPoint)
+			straight = GetDirection(point, GetPrevious(point));
+
+		// Every possible direction, the straight one in front of them
+		for (unsigned int i = 0; i < Topology::Directions + 1; i++)
 		{
 			// int adjacent = GetAdjacent(i, point, previousDirection);
-			int adjacent = GetAdjacent(i, point, false);
-			if (IsDiscovered(adjacent) || GetDirection(adjacent, point) == Direction::Invalid)
+			int adjacent;
+			if (i == 0)
+			{
+				adjacent = GetAdjacent(straight, point);
+			}
+			else
+			{
+				adjacent = GetAdjacent(i - 1, point, false);
+				if (straight != Direction::Invalid && GetDirection(adjacent, point) == straight)
+					continue;
+			}
+
+			if (GetDirection(adjacent, point) == Direction::Invalid || IsVisited(adjacent))
+				continue;
+
+			if (prune && IsPruned(adjacent))
 				continue;
 
 			bool pathIsBlocked = false;
@@ -93,8 +484,8 @@ bool MazeSolver::Solver::GetShortestPath(int initialPoint, List<Obstacle>& obsta
 			if (pathIsBlocked)
 				continue;
 			
-			previous[adjacent] = point;
-			Discover(adjacent);
+			SetPrevious(adjacent, point);
+			Visit(adjacent);
 			queue.Push(adjacent);
 		}
 	}
@@ -102,38 +493,261 @@ bool MazeSolver::Solver::GetShortestPath(int initialPoint, List<Obstacle>& obsta
 
 	// Return the result
 
-	if (!path.IsEmpty())
-		path = Stack<int>(); // Initialize to an empty path
+	path.Clear(); // Initialize to an empty path
 
 	if (point != EndPoint) // The exit is unreachable
 		return false;
 
 	path.Push(point);
-	while (previous[point] != initialPoint)
+	while (GetPrevious(point) != initialPoint)
 	{
-		path.Push(previous[point]);
-		point = previous[point];
+		point = GetPrevious(point);
+
+#if defined MAZESOLVER_TILED_STORAGE
+		// A tile that could not be mapped has no parents to follow
+		if (!cells.IsUsable())
+		{
+			path.Clear();
+			return false;
+		}
+#endif
+
+		path.Push(point);
 	}
 	
 	return true;
 }
 
+bool MazeSolver::Solver::GetKnownRoute(int initialPoint, int endPoint, Path& path)
+{
+	/*
+		let Q be a queue
+		let F be a path
+		let p be a point
+
+		Q.Push(initial point)
+		do
+			p = Q.Pop()
+
+			if p is the end
+				F = the parents of p up to the start
+				return F
+
+			for w in M.AdjacentEdges(p)
+				if w is not visited and the edge to w is known to be open and w is discovered or the end
+					w.Parent = p
+					label w as visited
+					Q.Push(w)
+		while Q is not empty
+	*/
+
+	PointQueue& queue = searchQueue;
+	queue.Clear();
+
+	ClearVisited();
+
+	Visit(initialPoint);
+	queue.Push(initialPoint);
+
+	int point = initialPoint;
+	do
+	{
+		point = queue.Pop();
+		if (point == endPoint)
+			break;
+
+		// Every possible direction
+		for (unsigned int i = 0; i < Topology::Directions; i++)
+		{
+			int adjacent = GetAdjacent(i, point, false);
+			if (adjacent == -1 || IsVisited(adjacent) || !IsOpen(adjacent, point))
+				continue;
+
+			// The runner knows only the edges around the points it has been to
+			if (adjacent != endPoint && !IsDiscovered(adjacent))
+				continue;
+
+			SetPrevious(adjacent, point);
+			Visit(adjacent);
+			queue.Push(adjacent);
+		}
+	}
+	while (!queue.IsEmpty());
+
+	path.Clear(); // Initialize to an empty path
+
+	if (point != endPoint)
+		return false;
+
+	while (point != initialPoint)
+	{
+		path.Push(point);
+		point = GetPrevious(point);
+
+#if defined MAZESOLVER_TILED_STORAGE
+		// A tile that could not be mapped has no parents to follow
+		if (!cells.IsUsable())
+		{
+			path.Clear();
+			return false;
+		}
+#endif
+	}
+
+	return true;
+}
+
 bool MazeSolver::Solver::IsDiscovered(int point)
 {
-	return discoveredPoints[point];
+#if defined MAZESOLVER_TILED_STORAGE
+	return cells.Get(TileStore::Layer::Discovered, point) != 0;
+#else
+	return (discoveredPoints[point / 8] & (1 << (point % 8))) != 0;
+#endif
 }
 
 void MazeSolver::Solver::Discover(int point)
 {
-	discoveredPoints[point] = true;
+#if defined MAZESOLVER_TILED_STORAGE
+	cells.Set(TileStore::Layer::Discovered, point, 1);
+#else
+	discoveredPoints[point / 8] |= 1 << (point % 8);
+#endif
 }
 
 void MazeSolver::Solver::ClearDiscovered()
 {
-	for (int i = 0; i < Width * Height; i++)
+#if defined MAZESOLVER_TILED_STORAGE
+	cells.Clear(TileStore::Layer::Discovered);
+#else
+	for (unsigned int i = 0; i < sizeof(discoveredPoints); i++)
+		discoveredPoints[i] = 0;
+#endif
+}
+
+bool MazeSolver::Solver::IsRemembered(int point)
+{
+#if defined MAZESOLVER_TILED_STORAGE
+	return cells.Get(TileStore::Layer::Remembered, point) != 0;
+#else
+	return (rememberedPoints[point / 8] & (1 << (point % 8))) != 0;
+#endif
+}
+
+void MazeSolver::Solver::Remember(int point)
+{
+#if defined MAZESOLVER_TILED_STORAGE
+	cells.Set(TileStore::Layer::Remembered, point, 1);
+#else
+	rememberedPoints[point / 8] |= 1 << (point % 8);
+#endif
+}
+
+void MazeSolver::Solver::Forget(int point)
+{
+#if defined MAZESOLVER_TILED_STORAGE
+	cells.Set(TileStore::Layer::Remembered, point, 0);
+#else
+	rememberedPoints[point / 8] &= ~(1 << (point % 8));
+#endif
+}
+
+void MazeSolver::Solver::ClearRemembered()
+{
+#if defined MAZESOLVER_TILED_STORAGE
+	cells.Clear(TileStore::Layer::Remembered);
+#else
+	for (unsigned int i = 0; i < sizeof(rememberedPoints); i++)
+		rememberedPoints[i] = 0;
+#endif
+}
+
+bool MazeSolver::Solver::IsPruned(int point)
+{
+#if defined MAZESOLVER_PRUNING
+	return pruner.IsPruned(point);
+#else
+	(void)point;
+	return false;
+#endif
+}
+
+bool MazeSolver::Solver::IsExitReachable()
+{
+#if defined MAZESOLVER_PRUNING
+	return pruner.IsExitReachable();
+#else
+	return true;
+#endif
+}
+
+bool MazeSolver::Solver::IsGoal()
+{
+	if (goalFunction == nullptr)
+		return CurrentPoint == EndPoint;
+
+	// The goal is detected where the runner really is
+	SendRun();
+	WaitForMotion();
+
+	return goalFunction();
+}
+
+bool MazeSolver::Solver::IsVisited(int point)
+{
+#if defined MAZESOLVER_TILED_STORAGE
+	return cells.Get(TileStore::Layer::Visited, point) != 0;
+#else
+	return visitedStamps[point] == visitedStamp;
+#endif
+}
+
+void MazeSolver::Solver::Visit(int point)
+{
+#if defined MAZESOLVER_TILED_STORAGE
+	cells.Set(TileStore::Layer::Visited, point, 1);
+#else
+	visitedStamps[point] = visitedStamp;
+#endif
+}
+
+void MazeSolver::Solver::ClearVisited()
+{
+#if defined MAZESOLVER_TILED_STORAGE
+	cells.Clear(TileStore::Layer::Visited);
+#else
+	visitedStamp++;
+
+	// The stamp wrapped around, the old stamps could match it again
+	if (visitedStamp == 0)
 	{
-		discoveredPoints[i] = false;
+		for (unsigned int i = 0; i < Width * Height; i++)
+		{
+			visitedStamps[i] = 0;
+		}
+
+		visitedStamp = 1;
 	}
+#endif
+}
+
+int MazeSolver::Solver::GetPrevious(int point)
+{
+#if defined MAZESOLVER_TILED_STORAGE
+	// The parent is always adjacent, so only the direction to it is stored
+	return GetAdjacent((Direction)(cells.Get(TileStore::Layer::Parent, point) + 1), point);
+#else
+	return previous[point];
+#endif
+}
+
+void MazeSolver::Solver::SetPrevious(int point, int previousPoint)
+{
+#if defined MAZESOLVER_TILED_STORAGE
+	cells.Set(TileStore::Layer::Parent, point, (unsigned int)GetDirection(previousPoint, point) - 1);
+#else
+	previous[point] = previousPoint;
+#endif
 }
 
 bool MazeSolver::Solver::IsAdjacent(int point)
@@ -148,36 +762,7 @@ bool MazeSolver::Solver::IsAdjacent(int point, int currentPoint)
 
 int MazeSolver::Solver::GetAdjacent(Direction direction, int currentPoint)
 {
-	int point;
-	switch (direction)
-	{
-	case Direction::Up:
-		point = currentPoint + Width;
-		if (point >= Width * Height)
-			return -1;
-
-		return point;
-	case Direction::Right:
-		point = currentPoint + 1;
-		if (point % Width == 0)
-			return -1;
-
-		return point;
-	case Direction::Left:
-		if (currentPoint % Width == 0)
-			return -1;
-
-		point = currentPoint - 1;
-		return point;
-	case Direction::Down:
-		if (currentPoint < Width)
-			return -1;
-
-		point = currentPoint - Width;
-		return point;
-	default:
-		return -1;
-	}
+	return Topology::GetAdjacent(direction, currentPoint);
 }
 
 int MazeSolver::Solver::GetAdjacent(unsigned int index)
@@ -188,49 +773,15 @@ int MazeSolver::Solver::GetAdjacent(unsigned int index)
 int MazeSolver::Solver::GetAdjacent(unsigned int index, int currentPoint, bool reverse)
 {
 #if defined MAZESOLVER_ASSERTS_ALLOWED
-	assert(index < 4);
+	assert(index < Topology::Directions);
 #endif
 
-	// Directional preference: Right -> Up -> Left -> Down
+	// The topology orders the directions by preference
 
 	if (reverse)
-		index = 3 - index;
-
-	switch (index)
-	{
-	case 0: // Right
-		return GetAdjacent(Direction::Right, currentPoint);
-	case 1: // Up
-		return GetAdjacent(Direction::Up, currentPoint);
-	case 2: // Left
-		return GetAdjacent(Direction::Left, currentPoint);
-	case 3: // Down
-		return GetAdjacent(Direction::Down, currentPoint);
-	/*
-	case 2:
-	case 3:
-		bool reverse = currentPoint % 2 != 0;
-		if (index == 3)
-			reverse = !reverse;
-
-		point = reverse ? currentPoint + Width : currentPoint + 1;
-		if (reverse)
-		{
-			if (point >= Width * Height)
-				return -1;
-		}
-		else
-		{
-			if (point % Width == 0)
-				return -1;
-		}
+		index = Topology::Directions - 1 - index;
 
-		return point;
-	*/
-	}
-
-	// Code should never be able to get here
-	return -1;
+	return GetAdjacent(Topology::GetDirection(index), currentPoint);
 }
 
 int MazeSolver::Solver::GetAdjacent(unsigned int index, Direction previousDirection)
@@ -282,38 +833,257 @@ MazeSolver::Direction MazeSolver::Solver::GetDirection(int point)
 
 MazeSolver::Direction MazeSolver::Solver::GetDirection(int point, int currentPoint)
 {
-	if (point == -1)
-		return Direction::Invalid;
+	return Topology::GetDirection(point, currentPoint);
+}
+
+double MazeSolver::Solver::GetTime()
+{
+	if (costModel.Clock == nullptr)
+		return 0;
+
+	return costModel.Clock();
+}
+
+bool MazeSolver::Solver::IsInterrupted()
+{
+	if (result.Status != SolveStatus::Unreachable) // Already stopped
+		return true;
 
-	int difference = point - currentPoint;
-	switch (difference)
+#if defined MAZESOLVER_TILED_STORAGE
+	// A tile that could not be mapped lost what the runner knew
+	if (!cells.IsUsable())
 	{
-	case Width:
-		return Direction::Up;
-	case 1:
-		if (point / Width != currentPoint / Width)
-			return Direction::Invalid;
+		result.Status = SolveStatus::StorageFailed;
+		return true;
+	}
+#endif
 
-		return Direction::Right;
-	case -1:
-		if (point / Width != currentPoint / Width)
-			return Direction::Invalid;
+	if (limits.MaxTime > 0 && GetTime() - solveStartTime >= limits.MaxTime)
+		result.Status = SolveStatus::TimeLimit;
+	else if (limits.Cancel != nullptr && limits.Cancel())
+		result.Status = SolveStatus::Cancelled;
 
-		return Direction::Left;
-	case -((int)Width):
-		return Direction::Down;
-	default:
-		return Direction::Invalid;
+	return result.Status != SolveStatus::Unreachable;
+}
+
+bool MazeSolver::Solver::CanScan()
+{
+	if (IsInterrupted())
+		return false;
+
+	if (limits.MaxScans > 0 && report.Scans >= limits.MaxScans)
+	{
+		result.Status = SolveStatus::ScanLimit;
+		return false;
+	}
+
+	return true;
+}
+
+bool MazeSolver::Solver::CanMove()
+{
+	if (IsInterrupted())
+		return false;
+
+	if (limits.MaxMoves > 0 && report.Moves >= limits.MaxMoves)
+	{
+		result.Status = SolveStatus::MoveLimit;
+		return false;
+	}
+
+	return true;
+}
+
+void MazeSolver::Solver::Explore(int point)
+{
+	if (IsDiscovered(point))
+		return;
+
+	Discover(point);
+	result.ExploredPoints++;
+
+	unsigned int distance = Topology::GetDistance(point, EndPoint);
+	if (distance < result.ClosestDistance)
+	{
+		result.ClosestPoint = point;
+		result.ClosestDistance = distance;
 	}
 }
 
+bool MazeSolver::Solver::IsOpen(int point, int currentPoint)
+{
+	unsigned int edge = Topology::GetEdge(point, currentPoint);
+#if defined MAZESOLVER_TILED_STORAGE
+	// The 2 edges to the higher points are stored with the lower one
+	return (cells.Get(TileStore::Layer::OpenEdges, edge / 2) & (1 << (edge % 2))) != 0;
+#else
+	return (openEdges[edge / 8] & (1 << (edge % 8))) != 0;
+#endif
+}
+
+void MazeSolver::Solver::Open(int point, int currentPoint)
+{
+	unsigned int edge = Topology::GetEdge(point, currentPoint);
+#if defined MAZESOLVER_TILED_STORAGE
+	cells.Set(TileStore::Layer::OpenEdges, edge / 2, cells.Get(TileStore::Layer::OpenEdges, edge / 2) | (1 << (edge % 2)));
+#else
+	openEdges[edge / 8] |= 1 << (edge % 8);
+#endif
+}
+
+bool MazeSolver::Solver::IsClosed(int point, int currentPoint)
+{
+	unsigned int edge = Topology::GetEdge(point, currentPoint);
+#if defined MAZESOLVER_TILED_STORAGE
+	return (cells.Get(TileStore::Layer::ClosedEdges, edge / 2) & (1 << (edge % 2))) != 0;
+#else
+	return (closedEdges[edge / 8] & (1 << (edge % 8))) != 0;
+#endif
+}
+
+void MazeSolver::Solver::Close(int point, int currentPoint)
+{
+	unsigned int edge = Topology::GetEdge(point, currentPoint);
+#if defined MAZESOLVER_TILED_STORAGE
+	cells.Set(TileStore::Layer::ClosedEdges, edge / 2, cells.Get(TileStore::Layer::ClosedEdges, edge / 2) | (1 << (edge % 2)));
+#else
+	closedEdges[edge / 8] |= 1 << (edge % 8);
+#endif
+}
+
+unsigned int MazeSolver::Solver::GetMarks(int point, int currentPoint)
+{
+#if !defined MAZESOLVER_NO_TREMAUX_MARKS
+	unsigned int edge = Topology::GetEdge(point, currentPoint);
+#if defined MAZESOLVER_TILED_STORAGE
+	return (cells.Get(TileStore::Layer::Marks, edge / 2) >> (edge % 2 * 2)) & 3;
+#else
+	return (tremauxMarks[edge / 4] >> (edge % 4 * 2)) & 3;
+#endif
+#else
+	(void)point;
+	(void)currentPoint;
+	return 0;
+#endif
+}
+
+void MazeSolver::Solver::Mark(int point, int currentPoint)
+{
+#if !defined MAZESOLVER_NO_TREMAUX_MARKS
+	// An edge is never gone along more than twice
+	unsigned int marks = GetMarks(point, currentPoint);
+	if (marks == 2)
+		return;
+
+	unsigned int edge = Topology::GetEdge(point, currentPoint);
+#if defined MAZESOLVER_TILED_STORAGE
+	cells.Set(TileStore::Layer::Marks, edge / 2, cells.Get(TileStore::Layer::Marks, edge / 2) + (1 << (edge % 2 * 2)));
+#else
+	tremauxMarks[edge / 4] += 1 << (edge % 4 * 2);
+#endif
+#else
+	(void)point;
+	(void)currentPoint;
+#endif
+}
+
+void MazeSolver::Solver::ClearMarks()
+{
+#if !defined MAZESOLVER_NO_TREMAUX_MARKS
+#if defined MAZESOLVER_TILED_STORAGE
+	cells.Clear(TileStore::Layer::Marks);
+#else
+	for (unsigned int i = 0; i < sizeof(tremauxMarks); i++)
+		tremauxMarks[i] = 0;
+#endif
+#endif
+}
+
+void MazeSolver::Solver::AddWall(int point, int currentPoint)
+{
+	Close(point, currentPoint);
+
+#if defined MAZESOLVER_PRUNING
+	pruner.AddWall(currentPoint, point);
+#endif
+
+	if (distanceField != nullptr)
+		distanceField->AddWall(currentPoint, point);
+}
+
+void MazeSolver::Solver::ClearEdges()
+{
+#if defined MAZESOLVER_TILED_STORAGE
+	cells.Clear(TileStore::Layer::OpenEdges);
+	cells.Clear(TileStore::Layer::ClosedEdges);
+#else
+	for (unsigned int i = 0; i < sizeof(openEdges); i++)
+	{
+		openEdges[i] = 0;
+		closedEdges[i] = 0;
+	}
+#endif
+}
+
 bool MazeSolver::Solver::IsAccessible(int point)
 {
 	Direction direction = GetDirection(point);
 	if (direction == Direction::Invalid)
 		return false;
 
-	return scanFunction(direction);
+	// The runner scans from where it really is
+	SendRun();
+	WaitForMotion();
+
+	bool accessible;
+	unsigned int range = 0;
+	{
+		MAZESOLVER_TRACE_SCOPE("Scan");
+		if (rangeScanFunction != nullptr)
+		{
+			range = rangeScanFunction(direction);
+			accessible = range > 0;
+		}
+		else
+		{
+			accessible = scanFunction(direction);
+		}
+	}
+
+	// A state saved in the scan function is the one before the scan
+	report.Scans++;
+
+	if (accessible)
+		Open(point, CurrentPoint);
+	else
+		AddWall(point, CurrentPoint);
+
+	if (range == 0)
+		return accessible;
+
+	// The rest of the ray is open up to the wall at its end
+	int rayPoint = point;
+	for (unsigned int i = 1; i < range; i++)
+	{
+		int nextPoint = GetAdjacent(direction, rayPoint);
+		if (nextPoint == -1)
+			break;
+
+		Open(nextPoint, rayPoint);
+		rayPoint = nextPoint;
+	}
+
+	int wallPoint = GetAdjacent(direction, rayPoint);
+	if (wallPoint != -1 && !IsClosed(wallPoint, rayPoint))
+	{
+		AddWall(wallPoint, rayPoint);
+
+		// The walls away from the runner are not scanned by the periodic correction, so it memorizes them here
+		if (activeSolution == Solution::PeriodicCorrection)
+			Memorize(knownObstacles, Obstacle(rayPoint, wallPoint));
+	}
+
+	return accessible;
 }
 
 void MazeSolver::Solver::Move(int point)
@@ -323,6 +1093,70 @@ void MazeSolver::Solver::Move(int point)
 	assert(direction != Direction::Invalid);
 #endif
 
+	// Only the moves along the edges known to be open are delayed, a turn ends the run
+	bool delayed = moveRunFunction != nullptr && IsOpen(point, CurrentPoint);
+	if (!delayed || direction != runDirection)
+		SendRun();
+
+	if (heading != Direction::Invalid)
+		report.Turns += Topology::GetTurns(heading, direction);
+
+	report.Moves++;
+	heading = direction;
+
+	int previousPoint = CurrentPoint;
 	CurrentPoint = point;
-	moveFunction(direction);
+
+	// The state is up to date when the move is sent, so that it can be saved from the movement functions
+	Open(point, previousPoint);
+
+	Explore(point);
+
+#if defined MAZESOLVER_PRUNING
+	pruner.SetCurrent(point);
+#endif
+
+	if (delayed)
+	{
+		runDirection = direction;
+		runLength++;
+	}
+	else
+	{
+		SendMove(direction, 1);
+	}
+}
+
+void MazeSolver::Solver::SendRun()
+{
+	if (runLength == 0)
+		return;
+
+	SendMove(runDirection, runLength);
+
+	runDirection = Direction::Invalid;
+	runLength = 0;
+}
+
+void MazeSolver::Solver::SendMove(Direction direction, unsigned int count)
+{
+#if defined MAZESOLVER_ASYNC_MOTION
+	lastMove = actuator.Send(direction, count);
+#else
+	MAZESOLVER_TRACE_SCOPE("Move");
+
+	if (count == 1)
+		moveFunction(direction);
+	else
+		moveRunFunction(direction, count);
+#endif
+}
+
+void MazeSolver::Solver::WaitForMotion()
+{
+#if defined MAZESOLVER_ASYNC_MOTION
+	MAZESOLVER_TRACE_SCOPE("Wait for motion");
+
+	actuator.Wait(lastMove);
+#endif
 }
\ No newline at end of file
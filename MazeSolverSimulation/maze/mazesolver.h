@@ -1,66 +1,175 @@
 #pragma once
 
-// Uncomment this to enable asserts
-// #define MAZESOLVER_ASSERTS_ALLOWED
+#include "config.h"
 
-#include "list.h"
-#include "stack.h"
-#include "queue.h"
-#include "obstacle.h"
+#include "containers.h"
+#include "costmodel.h"
+#include "solveresult.h"
+#include "topology.h"
+#include "hierarchicalplanner.h"
+#include "tilestore.h"
+#include "parallelplanner.h"
+#include "pruner.h"
+#include "actuator.h"
+#include "sensors.h"
+#include "plancache.h"
+#include "distancefield.h"
+#include "batchplanner.h"
+#include "tracer.h"
+#include "wallfollower.h"
+
+#if defined MAZESOLVER_TILED_STORAGE && (defined MAZESOLVER_OCTILE_TOPOLOGY || defined MAZESOLVER_HEX_TOPOLOGY)
+#error The tiled storage keeps the direction to the parent in 2 bits, which fits only the square grid
+#endif
 
 namespace MazeSolver
 {
 
-	enum class Direction : unsigned char
+	enum class Solution : unsigned char
 	{
-		Invalid,
-		Up,
-		Right,
-		Left,
-		Down
+		PeriodicCorrection,
+		AlgorithmicRunner,
+		FrontierExploration,
+		BestFirstRunner,
+		WallFollower
 	};
 
-	enum class Solution : unsigned char
+	enum class Planner : unsigned char
 	{
-		PeriodicCorrection,
-		AlgorithmicRunner
+		BreadthFirst,
+		Hierarchical,
+		Parallel
 	};
 
-	/// <summary>
-	/// A function type for the scan function with signature:
-	/// bool Scan(int point)
-	/// </summary>
-	/// <param>The direction of the point to scan.</param>
-	/// <returns>True if there is direct path to the point, false otherwise.</returns>
-	using ScanFunction = bool (*)(Direction);
-
-	/// <summary>
-	/// A function type for the movement function with signature:
-	/// void Move(int point)
-	/// </summary>
-	/// <param>The direction of the adjacent point to move to.</param>
-	using MovementFunction = void (*)(Direction);
+	enum class ScanPolicy : unsigned char
+	{
+		CostBased,
+		Everything,
+		Opportunistic,
+		PathOnly
+	};
 
 	class Solver
 	{
-
 	public:
 		// The dimensions of the maze are constant
-		static const unsigned int Width = 5;
-		static const unsigned int Height = 5;
+		static const unsigned int Width = MAZESOLVER_WIDTH;
+		static const unsigned int Height = MAZESOLVER_HEIGHT;
 
 		// The index of the start point
 		const int StartPoint = 0;
 
 		// The index of the exit point
-		const int EndPoint = 24;
+		const int EndPoint = Width * Height - 1;
+
+		// The largest size of a saved state in bytes: the header, the points and the edges that are known,
+		// the report and the result, and the points remembered by the runner
+		static const unsigned int StateSize = 5 * sizeof(unsigned int) + 2 +
+			2 * ((Width * Height + 7) / 8) + 2 * ((Topology::Edges + 7) / 8) +
+			sizeof(CostReport) + sizeof(SolveResult) +
+			sizeof(unsigned int) + Width * Height * sizeof(int);
 
 	private:
-		bool discoveredPoints[Width * Height];
+#if defined MAZESOLVER_TILED_STORAGE
+		// The points and the edges known to the runner and the state of the search are paged in from a file
+		TileStore cells;
+#else
+		// The points discovered by the runner, one bit per point
+		unsigned char discoveredPoints[(Width * Height + 7) / 8];
+
+		// The points remembered by the runner to go to later, one bit per point
+		unsigned char rememberedPoints[(Width * Height + 7) / 8];
+
+		// A point is visited by the search if it is stamped by the current search,
+		// so that a new search does not have to clear every point
+		unsigned int visitedStamps[Width * Height];
+		unsigned int visitedStamp = 1;
+
+		// The parent point for each point of the search
+		int previous[Width * Height];
+#endif
+
+#if defined MAZESOLVER_PRUNING
+		// The dead ends found from the walls the runner has scanned
+		Pruner pruner;
+#endif
 
 		// The external functions that the solver calls
 		ScanFunction scanFunction;
 		MovementFunction moveFunction;
+		MoveRunFunction moveRunFunction = nullptr;
+		RangeScanFunction rangeScanFunction = nullptr;
+		GoalFunction goalFunction = nullptr;
+
+#if !defined MAZESOLVER_TILED_STORAGE
+		// The edges known to be open and the ones known to be walls, one bit per edge of the topology
+		unsigned char openEdges[(Topology::Edges + 7) / 8];
+		unsigned char closedEdges[(Topology::Edges + 7) / 8];
+#endif
+
+		// The moves along the open edges that are not sent yet, they are sent as a single run
+		Direction runDirection = Direction::Invalid;
+		unsigned int runLength = 0;
+
+#if defined MAZESOLVER_ASYNC_MOTION
+		// Performs the moves while the solver plans, the scans wait for the last move
+		Actuator actuator;
+		unsigned int lastMove = 0;
+#endif
+
+		// The containers are kept between the searches, so that solving does not allocate
+		ObstacleList knownObstacles;
+		Path plannedPath;
+		Path contingencyPath;
+		PointQueue searchQueue;
+		CandidateList runnerMemory;
+		Path runnerRoute;
+
+		// The planner used when the path has to be recalculated
+		Planner planner = Planner::BreadthFirst;
+
+		// The planner of the current solve, the selected one until a search runs over the planning budget
+		Planner activePlanner = Planner::BreadthFirst;
+
+#if defined MAZESOLVER_HIERARCHICAL_PLANNER
+		HierarchicalPlanner hierarchicalPlanner;
+#endif
+#if defined MAZESOLVER_PARALLEL_PLANNER
+		ParallelPlanner parallelPlanner;
+#endif
+
+		// The searches already done with the same walls, shared with other solvers
+		PlanCache* planCache = nullptr;
+
+		// The Zobrist hash of the known walls
+		unsigned long long wallHash = 0;
+
+		// The distances to the goals kept up to date with the scanned walls, shared with other solvers
+		DistanceField* distanceField = nullptr;
+
+		// The points scanned around the runner by the periodic correction
+		ScanPolicy scanPolicy = ScanPolicy::CostBased;
+
+		// The cost of the actions of the runner and what the last solve took
+		CostModel costModel;
+		CostReport report;
+
+		// The direction of the last move, turning is counted against it
+		Direction heading = Direction::Invalid;
+
+		// The limits of a solve and how the last one ended
+		Limits limits;
+		SolveResult result;
+		double solveStartTime = 0;
+
+#if !defined MAZESOLVER_NO_TREMAUX_MARKS && !defined MAZESOLVER_TILED_STORAGE
+		// The times the wall follower went along every edge after it looped, 2 bits per edge
+		unsigned char tremauxMarks[(Topology::Edges + 3) / 4];
+#endif
+
+		// The solution of the last solve, and whether it continues from a loaded state
+		Solution activeSolution = Solution::PeriodicCorrection;
+		bool resuming = false;
 
 	public:
 		// The index of the current point
@@ -77,10 +186,140 @@ namespace MazeSolver
 		/// Solves the maze.
 		/// </summary>
 		/// <param name="solution">The solution to use when solving.</param>
+		/// <returns>The result that converts to true if the maze is solved, false if there are no paths to the exit, a limit was hit or the wall follower gave up.</returns>
+		SolveResult Solve(Solution solution);
+
+		/// <summary>
+		/// Continues the solve whose state was loaded, the runner has to be at the current point of the state.
+		/// The report continues from the one of the state.
+		/// </summary>
+		/// <returns>The result that converts to true if the maze is solved, false if there are no paths to the exit, a limit was hit or the wall follower gave up.</returns>
+		SolveResult Resume();
+
+		/// <summary>
+		/// Saves where the runner is, what it knows about the maze and what the solve has done.
+		/// The state is up to date in the scan and the movement functions, so that every action can be checkpointed,
+		/// with the asynchronous motion only in the scan function. The state is loaded by a solver of the same build.
+		/// </summary>
+		/// <param name="buffer">A place for the state, the state size of bytes always fits.</param>
+		/// <param name="size">The size of the place in bytes.</param>
+		/// <returns>The size of the saved state in bytes, 0 if it does not fit.</returns>
+		unsigned int SaveState(unsigned char* buffer, unsigned int size);
+
+		/// <summary>
+		/// Loads a saved state, the solve is then continued with resume.
+		/// </summary>
+		/// <param name="buffer">The saved state.</param>
+		/// <param name="size">The size of the saved state in bytes.</param>
+		/// <returns>True if the state is loaded, false if it is not a state of a maze of this size.</returns>
+		bool LoadState(const unsigned char* buffer, unsigned int size);
+
+		/// <summary>
+		/// Sets the planner used to search for the shortest path.
+		/// The planners that are not compiled are replaced by the breadth-first search.
+		/// </summary>
+		/// <param name="planner">The planner to use.</param>
+		void SetPlanner(Planner planner);
+
+		/// <summary>
+		/// Sets the cache of the searches, a search done before with the same known walls is then looked up.
+		/// The cache can be shared by the solvers of the same layouts.
+		/// </summary>
+		/// <param name="planCache">The cache to use, or null to search every time.</param>
+		void SetPlanCache(PlanCache* planCache);
+
+		/// <summary>
+		/// Sets the distance field that every wall found by the scans is added to,
+		/// the distances to the goals can then be queried from it at any time.
+		/// The field can be shared by the solvers of the same layout.
+		/// </summary>
+		/// <param name="distanceField">The field to update, or null to update none.</param>
+		void SetDistanceField(DistanceField* distanceField);
+
+		/// <summary>
+		/// Sets which points around the runner the periodic correction scans:
+		/// everything, the points towards the exit besides the path, only the next point of the path,
+		/// or everything or only the path depending on the cost model.
+		/// </summary>
+		/// <param name="scanPolicy">The policy to use.</param>
+		void SetScanPolicy(ScanPolicy scanPolicy);
+
+		/// <summary>
+		/// Sets the function that moves several points straight at once.
+		/// The moves along the edges known to be open are then sent as straight runs.
+		/// </summary>
+		/// <param name="moveRunFunction">Function that moves straight, or null to move point by point.</param>
+		void SetMoveRunFunction(MoveRunFunction moveRunFunction);
+
+		/// <summary>
+		/// Sets the function that measures how far the runner can go straight, it is then used instead of the scan function.
+		/// A single scan finds every edge along the ray and the wall at its end.
+		/// </summary>
+		/// <param name="rangeScanFunction">Function that measures the range, or null to scan one edge at a time.</param>
+		void SetRangeScanFunction(RangeScanFunction rangeScanFunction);
+
+		/// <summary>
+		/// Sets the function that recognizes the goal when the runner arrives at it,
+		/// the frontier exploration explores the maze until the function does.
+		/// </summary>
+		/// <param name="goalFunction">Function that detects the goal, or null if the exit is the goal.</param>
+		void SetGoalFunction(GoalFunction goalFunction);
+
+		/// <summary>
+		/// Sets the cost of the actions, the solutions weigh scanning against moving with it.
+		/// The clock of the cost model also measures the time limit of the solve.
+		/// </summary>
+		/// <param name="costModel">The cost model to use.</param>
+		void SetCostModel(const CostModel& costModel);
+
+		/// <summary>
+		/// Sets the limits of the moves, the scans and the time of a solve, and the cancellation function.
+		/// The time is measured with the clock of the cost model, so a time limit needs the cost model to be set first.
+		/// </summary>
+		/// <param name="limits">The limits to use.</param>
+		/// <returns>True if the limits are used, false if the time is limited and the cost model has no clock.</returns>
+		bool SetLimits(const Limits& limits);
+
+#if defined MAZESOLVER_TILED_STORAGE
+		/// <summary>
+		/// Backs the tiled storage with a file instead of the temporary file of the solver, it is set before solving.
+		/// Every solver has to use a file of its own.
+		/// </summary>
+		/// <param name="path">The path to the file, it is created if it does not exist, or null for a new temporary file.</param>
+		/// <returns>True if the file is opened, false otherwise, then every solve ends with the storage failed.</returns>
+		bool SetTileFile(const char* path);
+#endif
+
+		/// <summary>
+		/// Gets the actions taken by the last solve with the predicted and the measured time.
+		/// </summary>
+		/// <returns>The report of the last solve.</returns>
+		const CostReport& GetReport();
+
+		/// <summary>
+		/// Searches for a path to the exit with the selected planner through the memorized obstacles, the runner does not move.
+		/// The hierarchical planner returns only the next segment of the path.
+		/// </summary>
+		/// <param name="initialPoint">The starting point.</param>
+		/// <param name="obstacles">A list of obstacles.</param>
+		/// <param name="path">A place to store the path.</param>
 		/// <returns>True if the maze is solved, false if there are no paths to the exit.</returns>
-		bool Solve(Solution solution);
+		bool Plan(int initialPoint, MazeSolver::ObstacleList& obstacles, MazeSolver::Path& path);
+
+		/// <summary>
+		/// Remembers an obstacle for the planners, the obstacles are forgotten when a solve starts.
+		/// </summary>
+		/// <param name="obstacles">A list of obstacles.</param>
+		/// <param name="obstacle">The obstacle to remember.</param>
+		void Memorize(MazeSolver::ObstacleList& obstacles, MazeSolver::Obstacle obstacle);
 
 	private:
+		/// <summary>
+		/// Solves the maze with the active solution from what the solver knows.
+		/// </summary>
+		/// <returns>The result of the solve.</returns>
+		SolveResult Execute();
+
 		/// <summary>
 		/// Follows the BFS shortest path, if an obstacle is hit, the shortest path is recalculated.
 		/// </summary>
@@ -93,6 +332,28 @@ namespace MazeSolver
 		/// <returns>True if the maze is solved, false if there are no paths to the exit.</returns>
 		bool AlgorithmicRunnerSolution();
 
+		/// <summary>
+		/// Explores the closest points that are known to be accessible until the goal is detected,
+		/// the location of the goal is not used.
+		/// </summary>
+		/// <returns>True if the goal is found, false if every accessible point is explored.</returns>
+		bool FrontierExplorationSolution();
+
+		/// <summary>
+		/// Goes to the point known to be accessible with the lowest route from the runner plus the estimated distance to the exit.
+		/// The distance field estimates the distance when one is set, the distance ignoring the walls otherwise.
+		/// </summary>
+		/// <returns>True if the maze is solved, false if there are no paths to the exit.</returns>
+		bool BestFirstRunnerSolution();
+
+		/// <summary>
+		/// Heads for the exit and follows the walls that block it with the Pledge count of the turns,
+		/// the state of the runner fits a few variables and nothing is searched.
+		/// If the walls lead it around in a loop, the runner explores with the Tremaux marks on the edges.
+		/// </summary>
+		/// <returns>True if the maze is solved, false if there are no paths to the exit or the runner loops without the marks.</returns>
+		bool WallFollowerSolution();
+
 		/// <summary>
 		/// Searches for the shortest path.
 		/// </summary>
@@ -100,13 +361,87 @@ namespace MazeSolver
 		/// <param name="obstacles">A list of obstacles.</param>
 		/// <param name="path">A place to store the shortest path.</param>
 		/// <returns>True if the maze is solved, false if there are no paths to the exit.</returns>
-		bool GetShortestPath(int initialPoint, MazeSolver::List<MazeSolver::Obstacle>& obstacles, MazeSolver::Stack<int>& path);
+		bool GetShortestPath(int initialPoint, MazeSolver::ObstacleList& obstacles, MazeSolver::Path& path);
+
+		/// <summary>
+		/// Checks whether a wall is known between the points of a path.
+		/// </summary>
+		/// <param name="path">The path to check, the move from the current point to the next point is not checked.</param>
+		/// <returns>True if the path crosses a known wall, false otherwise.</returns>
+		bool IsBlockedAhead(MazeSolver::Path& path);
+
+		/// <summary>
+		/// Searches for the shortest route through the discovered points along the edges known to be open.
+		/// </summary>
+		/// <param name="initialPoint">The starting point.</param>
+		/// <param name="endPoint">The point to get to.</param>
+		/// <param name="path">A place to store the route.</param>
+		/// <returns>True if the route is found, false otherwise.</returns>
+		bool GetKnownRoute(int initialPoint, int endPoint, MazeSolver::Path& path);
+
+		/// <summary>
+		/// Searches for the shortest route through the discovered points along the edges known to be open
+		/// to the closest point that is accessible but not discovered yet.
+		/// Of the closest points, the one with the fewest unexplored points around it is taken.
+		/// </summary>
+		/// <param name="initialPoint">The starting point.</param>
+		/// <param name="path">A place to store the route.</param>
+		/// <returns>True if the route is found, false if every accessible point is discovered.</returns>
+		bool GetFrontierRoute(int initialPoint, MazeSolver::Path& path);
+
+		/// <summary>
+		/// Searches for the shortest route through the discovered points along the edges known to be open
+		/// to the point that is accessible but not discovered yet with the lowest route plus estimated distance to the exit.
+		/// </summary>
+		/// <param name="initialPoint">The starting point.</param>
+		/// <param name="path">A place to store the route.</param>
+		/// <returns>True if the route is found, false if no such point can reach the exit.</returns>
+		bool GetBestFirstRoute(int initialPoint, MazeSolver::Path& path);
+
+		/// <summary>
+		/// Searches for the path to use if the next point turns out to be behind a wall,
+		/// the runner is moving meanwhile.
+		/// </summary>
+		/// <param name="obstacles">A list of obstacles.</param>
+		/// <param name="nextPoint">The next point of the path.</param>
+		/// <param name="path">A place to store the path.</param>
+		/// <returns>True if the path is found, false if there are no paths or nothing is searched.</returns>
+		bool PlanContingency(MazeSolver::ObstacleList& obstacles, int nextPoint, MazeSolver::Path& path);
+
+		/// <summary>
+		/// Finds the first of the adjacent points that the runner can go to, only the edges that are not known are scanned.
+		/// </summary>
+		/// <param name="points">The adjacent points in the order of preference.</param>
+		/// <param name="count">The number of the points.</param>
+		/// <param name="index">A place to store the index of the found point, the count if none is accessible.</param>
+		/// <returns>True if the points are checked, false if the scans are stopped by a limit.</returns>
+		bool FindAccessible(const int* points, unsigned int count, unsigned int& index);
 
 	private:
+		// The wall follower is shared with the standalone follower, it goes through the solver to scan, move and mark
+		friend class WallFollower<Solver>;
+
 		bool IsDiscovered(int point);
 		void Discover(int point);
 		void ClearDiscovered();
 
+		bool IsRemembered(int point);
+		void Remember(int point);
+		void Forget(int point);
+		void ClearRemembered();
+
+		bool IsPruned(int point);
+		bool IsExitReachable();
+		bool IsGoal();
+		unsigned int GetEstimate(int point);
+
+		bool IsVisited(int point);
+		void Visit(int point);
+		void ClearVisited();
+
+		int GetPrevious(int point);
+		void SetPrevious(int point, int previousPoint);
+
 		bool IsAdjacent(int point);
 		bool IsAdjacent(int point, int currentPoint);
 
@@ -119,8 +454,30 @@ namespace MazeSolver
 		Direction GetDirection(int point);
 		Direction GetDirection(int point, int currentPoint);
 
+		double GetTime();
+
+		bool IsInterrupted();
+		bool CanScan();
+		bool CanMove();
+		void Explore(int point);
+
+		bool IsOpen(int point, int currentPoint);
+		void Open(int point, int currentPoint);
+
+		bool IsClosed(int point, int currentPoint);
+		void Close(int point, int currentPoint);
+		void AddWall(int point, int currentPoint);
+		void ClearEdges();
+
+		unsigned int GetMarks(int point, int currentPoint);
+		void Mark(int point, int currentPoint);
+		void ClearMarks();
+
 		bool IsAccessible(int point);
 		void Move(int point);
+		void SendRun();
+		void SendMove(Direction direction, unsigned int count);
+		void WaitForMotion();
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,373 @@
+#include "parallelplanner.h"
+
+#if defined MAZESOLVER_PARALLEL_PLANNER
+
+MazeSolver::ParallelPlanner::ParallelPlanner()
+	: walls()
+{
+}
+
+MazeSolver::ParallelPlanner::~ParallelPlanner()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	wake.notify_all();
+
+	// The calling thread is the first worker
+	for (unsigned int i = 1; i < threadCount; i++)
+		threads[i].join();
+}
+
+void MazeSolver::ParallelPlanner::AddObstacle(Obstacle obstacle)
+{
+	if (obstacle.Second - obstacle.First == 1)
+		walls[obstacle.First] |= WallRight;
+	else
+		walls[obstacle.First] |= WallUp;
+}
+
+void MazeSolver::ParallelPlanner::Clear()
+{
+	for (unsigned int i = 0; i < Cells; i++)
+		walls[i] = 0;
+}
+
+bool MazeSolver::ParallelPlanner::GetShortestPath(int initialPoint, int endPoint, Path& path)
+{
+	/*
+		let F be a frontier
+		let N be the next frontier
+
+		F = { initial point }
+		do
+			if F is large compared to the unvisited points
+				for every unvisited point w in parallel
+					w.Parent = the first point of F adjacent to w
+			else
+				for every point p of F in parallel
+					for w in M.AdjacentEdges(p)
+						if w is not discovered and is accessible
+							w.Parent = the first of the points proposing w
+			N = the points with a parent in the order of the serial queue
+			F = N
+		while F is not empty and the exit is not discovered
+	*/
+
+	path.Clear(); // Initialize to an empty path
+
+	if (initialPoint == endPoint)
+		return true;
+
+	Start();
+	Run(&ParallelPlanner::ClearSearch);
+
+	visited[initialPoint / 64] |= 1ULL << (initialPoint % 64);
+	inFrontier[initialPoint / 64] |= 1ULL << (initialPoint % 64);
+	parent[initialPoint] = initialPoint;
+	order[initialPoint] = 0;
+	frontier[0] = initialPoint;
+	frontierSize = 1;
+
+	unsigned int visitedCount = 1;
+	bool bottomUp = false;
+	while (frontierSize != 0 && (visited[endPoint / 64] & (1ULL << (endPoint % 64))) == 0)
+	{
+		// Direction-optimizing: go bottom-up while the frontier is large
+		if (!bottomUp && frontierSize * 4 > (Cells - visitedCount) * 4 / TopDownFactor)
+			bottomUp = true;
+		else if (bottomUp && frontierSize < Cells / BottomUpFactor)
+			bottomUp = false;
+
+		slotCount = frontierSize * 4;
+		if (bottomUp)
+		{
+			Run(&ParallelPlanner::ClearSlots);
+			Run(&ParallelPlanner::BottomUp);
+		}
+		else
+		{
+			Run(&ParallelPlanner::TopDown);
+		}
+
+		// The proposals are compacted into the next frontier in the order of the serial queue
+		Run(&ParallelPlanner::Count);
+
+		unsigned int total = 0;
+		for (unsigned int i = 0; i < threadCount; i++)
+		{
+			offsets[i] = total;
+			total += counts[i];
+		}
+
+		Run(&ParallelPlanner::Commit);
+
+		int* temp = frontier;
+		frontier = next;
+		next = temp;
+
+		frontierSize = total;
+		visitedCount += total;
+	}
+
+	if ((visited[endPoint / 64] & (1ULL << (endPoint % 64))) == 0) // The exit is unreachable
+		return false;
+
+	int point = endPoint;
+	path.Push(point);
+	while (parent[point] != initialPoint)
+	{
+		point = parent[point];
+		path.Push(point);
+	}
+
+	return true;
+}
+
+bool MazeSolver::ParallelPlanner::IsOpen(int point, unsigned int direction)
+{
+	// 4 possible directions: Right -> Up -> Left -> Down
+	switch (direction)
+	{
+	case 0:
+		return (point + 1) % Width != 0 && (walls[point] & WallRight) == 0;
+	case 1:
+		return point + Width < Cells && (walls[point] & WallUp) == 0;
+	case 2:
+		return point % Width != 0 && (walls[point - 1] & WallRight) == 0;
+	case 3:
+		return point >= (int)Width && (walls[point - Width] & WallUp) == 0;
+	}
+
+	// Code should never be able to get here
+	return false;
+}
+
+int MazeSolver::ParallelPlanner::GetAdjacent(int point, unsigned int direction)
+{
+	switch (direction)
+	{
+	case 0:
+		return point + 1;
+	case 1:
+		return point + Width;
+	case 2:
+		return point - 1;
+	case 3:
+		return point - Width;
+	}
+
+	// Code should never be able to get here
+	return -1;
+}
+
+void MazeSolver::ParallelPlanner::Start()
+{
+	if (threadCount != 0)
+		return;
+
+	threadCount = std::thread::hardware_concurrency();
+	if (threadCount == 0)
+		threadCount = 1;
+	if (threadCount > MaxThreads)
+		threadCount = MaxThreads;
+
+	for (unsigned int i = 1; i < threadCount; i++)
+		threads[i] = std::thread(&ParallelPlanner::Work, this, i);
+}
+
+void MazeSolver::ParallelPlanner::Run(Task task)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		this->task = task;
+		pending = threadCount - 1;
+		round++;
+	}
+	wake.notify_all();
+
+	(this->*task)(0);
+
+	std::unique_lock<std::mutex> lock(mutex);
+	done.wait(lock, [this] { return pending == 0; });
+}
+
+void MazeSolver::ParallelPlanner::Work(unsigned int worker)
+{
+	unsigned int seen = 0;
+	while (true)
+	{
+		Task current;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			wake.wait(lock, [this, seen] { return stopping || round != seen; });
+			if (stopping)
+				return;
+
+			seen = round;
+			current = task;
+		}
+
+		(this->*current)(worker);
+
+		std::lock_guard<std::mutex> lock(mutex);
+		if (--pending == 0)
+			done.notify_one();
+	}
+}
+
+void MazeSolver::ParallelPlanner::GetRange(unsigned int worker, unsigned int total, unsigned int& begin, unsigned int& end)
+{
+	begin = (unsigned int)((unsigned long long)total * worker / threadCount);
+	end = (unsigned int)((unsigned long long)total * (worker + 1) / threadCount);
+}
+
+void MazeSolver::ParallelPlanner::ClearSearch(unsigned int worker)
+{
+	unsigned int begin, end;
+
+	GetRange(worker, Words, begin, end);
+	for (unsigned int i = begin; i < end; i++)
+	{
+		visited[i].store(0, std::memory_order_relaxed);
+		inFrontier[i].store(0, std::memory_order_relaxed);
+	}
+
+	GetRange(worker, Cells, begin, end);
+	for (unsigned int i = begin; i < end; i++)
+		keys[i].store(NoKey, std::memory_order_relaxed);
+}
+
+void MazeSolver::ParallelPlanner::ClearSlots(unsigned int worker)
+{
+	unsigned int begin, end;
+	GetRange(worker, slotCount, begin, end);
+
+	for (unsigned int i = begin; i < end; i++)
+		slots[i] = -1;
+}
+
+void MazeSolver::ParallelPlanner::TopDown(unsigned int worker)
+{
+	unsigned int begin, end;
+	GetRange(worker, frontierSize, begin, end);
+
+	for (unsigned int position = begin; position < end; position++)
+	{
+		int point = frontier[position];
+		for (unsigned int direction = 0; direction < 4; direction++)
+		{
+			unsigned int slot = position * 4 + direction;
+			slots[slot] = -1;
+
+			if (!IsOpen(point, direction))
+				continue;
+
+			int adjacent = GetAdjacent(point, direction);
+			if ((visited[adjacent / 64].load(std::memory_order_relaxed) & (1ULL << (adjacent % 64))) != 0)
+				continue;
+
+			slots[slot] = adjacent;
+
+			// The proposal of the point that comes first in the serial queue wins
+			unsigned int key = keys[adjacent].load(std::memory_order_relaxed);
+			while (slot < key && !keys[adjacent].compare_exchange_weak(key, slot, std::memory_order_relaxed))
+			{
+			}
+		}
+	}
+}
+
+void MazeSolver::ParallelPlanner::BottomUp(unsigned int worker)
+{
+	unsigned int begin, end;
+	GetRange(worker, Words, begin, end);
+
+	for (unsigned int word = begin; word < end; word++)
+	{
+		unsigned long long unvisited = ~visited[word].load(std::memory_order_relaxed);
+		while (unvisited != 0)
+		{
+			unsigned int bit = 0;
+			while ((unvisited & (1ULL << bit)) == 0)
+				bit++;
+			unvisited &= ~(1ULL << bit);
+
+			int point = word * 64 + bit;
+			if (point >= (int)Cells)
+				break;
+
+			// Look for the parent in the frontier, the direction is the one from the parent to the point
+			unsigned int best = NoKey;
+			for (unsigned int direction = 0; direction < 4; direction++)
+			{
+				unsigned int reverse = (direction + 2) % 4;
+				if (!IsOpen(point, reverse))
+					continue;
+
+				int adjacent = GetAdjacent(point, reverse);
+				if ((inFrontier[adjacent / 64].load(std::memory_order_relaxed) & (1ULL << (adjacent % 64))) == 0)
+					continue;
+
+				unsigned int key = order[adjacent] * 4 + direction;
+				if (key < best)
+					best = key;
+			}
+
+			if (best == NoKey)
+				continue;
+
+			keys[point].store(best, std::memory_order_relaxed);
+			slots[best] = point;
+		}
+	}
+}
+
+void MazeSolver::ParallelPlanner::Count(unsigned int worker)
+{
+	unsigned int begin, end;
+	GetRange(worker, slotCount, begin, end);
+
+	unsigned int count = 0;
+	for (unsigned int slot = begin; slot < end; slot++)
+	{
+		if (slots[slot] != -1 && keys[slots[slot]].load(std::memory_order_relaxed) == slot)
+			count++;
+	}
+
+	counts[worker] = count;
+}
+
+void MazeSolver::ParallelPlanner::Commit(unsigned int worker)
+{
+	unsigned int begin, end;
+
+	// The old frontier
+	GetRange(worker, frontierSize, begin, end);
+	for (unsigned int position = begin; position < end; position++)
+	{
+		int point = frontier[position];
+		inFrontier[point / 64].fetch_and(~(1ULL << (point % 64)), std::memory_order_relaxed);
+	}
+
+	// The next frontier
+	GetRange(worker, slotCount, begin, end);
+	unsigned int position = offsets[worker];
+	for (unsigned int slot = begin; slot < end; slot++)
+	{
+		int point = slots[slot];
+		if (point == -1 || keys[point].load(std::memory_order_relaxed) != slot)
+			continue;
+
+		next[position] = point;
+		order[point] = position;
+		parent[point] = frontier[slot / 4];
+		position++;
+
+		visited[point / 64].fetch_or(1ULL << (point % 64), std::memory_order_relaxed);
+		inFrontier[point / 64].fetch_or(1ULL << (point % 64), std::memory_order_relaxed);
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "config.h"
+
+#if defined MAZESOLVER_PARALLEL_PLANNER
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "containers.h"
+#include "obstacle.h"
+
+namespace MazeSolver
+{
+
+	// Level-synchronous BFS running on a thread pool, finds the same path as the serial BFS
+	class ParallelPlanner
+	{
+
+	public:
+		// The dimensions of the maze
+		static const unsigned int Width = MAZESOLVER_WIDTH;
+		static const unsigned int Height = MAZESOLVER_HEIGHT;
+		static const unsigned int Cells = Width * Height;
+		static const unsigned int Words = (Cells + 63) / 64;
+
+		// The maximum number of threads, including the calling thread
+		static const unsigned int MaxThreads = MAZESOLVER_PLANNER_THREADS;
+
+	public:
+		/// <summary>
+		/// Constructor.
+		/// </summary>
+		ParallelPlanner();
+
+		/// <summary>
+		/// Destructor.
+		/// </summary>
+		~ParallelPlanner();
+
+		/// <summary>
+		/// Adds a wall to the map.
+		/// </summary>
+		/// <param name="obstacle">The wall between two adjacent points.</param>
+		void AddObstacle(Obstacle obstacle);
+
+		/// <summary>
+		/// Removes every wall from the map.
+		/// </summary>
+		void Clear();
+
+		/// <summary>
+		/// Searches for the shortest path.
+		/// </summary>
+		/// <param name="initialPoint">The starting point.</param>
+		/// <param name="endPoint">The exit point.</param>
+		/// <param name="path">A place to store the shortest path.</param>
+		/// <returns>True if the exit is reachable, false otherwise.</returns>
+		bool GetShortestPath(int initialPoint, int endPoint, Path& path);
+
+	private:
+		using Task = void (ParallelPlanner::*)(unsigned int worker);
+
+		// Bits of the wall map, each point stores the walls on its upper and right edges
+		static const unsigned char WallUp = 1;
+		static const unsigned char WallRight = 2;
+
+		static const unsigned int NoKey = 0xFFFFFFFF;
+
+		// The frontier is expanded bottom-up when it has more edges than the unvisited points divided by this
+		static const unsigned int TopDownFactor = 14;
+		// The frontier is expanded top-down again when it has less points than all points divided by this
+		static const unsigned int BottomUpFactor = 24;
+
+	private:
+		bool IsOpen(int point, unsigned int direction);
+		int GetAdjacent(int point, unsigned int direction);
+
+		void Start();
+		void Run(Task task);
+		void Work(unsigned int worker);
+		void GetRange(unsigned int worker, unsigned int total, unsigned int& begin, unsigned int& end);
+
+		void ClearSearch(unsigned int worker);
+		void ClearSlots(unsigned int worker);
+		void TopDown(unsigned int worker);
+		void BottomUp(unsigned int worker);
+		void Count(unsigned int worker);
+		void Commit(unsigned int worker);
+
+	private:
+		// The known walls
+		unsigned char walls[Cells];
+
+		// The state of the search
+		int parent[Cells];
+		unsigned int order[Cells];
+		std::atomic<unsigned int> keys[Cells];
+		std::atomic<unsigned long long> visited[Words];
+		std::atomic<unsigned long long> inFrontier[Words];
+
+		// The frontier in the order of the serial queue
+		int frontiers[2][Cells];
+		int* frontier = frontiers[0];
+		int* next = frontiers[1];
+		unsigned int frontierSize = 0;
+
+		// Each point of the frontier proposes a point for every direction, the lowest proposal wins
+		int slots[4 * Cells];
+		unsigned int slotCount = 0;
+
+		unsigned int counts[MaxThreads];
+		unsigned int offsets[MaxThreads];
+
+		// The thread pool
+		std::thread threads[MaxThreads];
+		unsigned int threadCount = 0;
+
+		std::mutex mutex;
+		std::condition_variable wake;
+		std::condition_variable done;
+		Task task = nullptr;
+		unsigned int round = 0;
+		unsigned int pending = 0;
+		bool stopping = false;
+
+	};
+
+}
+
+#endif
\ No newline at end of file
@@ -6,35 +6,85 @@ bool MazeSolver::Solver::PeriodicCorrectionSolution()
 		let I be a runner
 		let L be a list
 		let F be a path
+		let C be a path
 
 		repeat
-			F = shortest path from I.CurrentPoint to the exit with L considered
+			if C is not prepared
+				F = shortest path from I.CurrentPoint to the exit with L considered
+			else
+				F = C
 			if F is not found
 				end
 			repeat
 				if I reached the exit
 					end
-				L.Add(I.AdjacentObstacles)
-				if I.CanGoTo(F.NextPoint)
+				L.Add(I.AdjacentObstacles allowed by the scan policy)
+				if I.CanGoTo(F.NextPoint) and no wall of L is along F
 					I.Go(F.NextPoint)
+					while I is moving
+						C = shortest path from I.CurrentPoint to the exit with L and F.NextPoint blocked considered
 				else
+					if C is found and does not start behind L
+						label C as prepared
 					break
 	*/
 
-	List<Obstacle> obstacles;
+	ObstacleList& obstacles = knownObstacles;
+	obstacles.Clear();
+	wallHash = 0;
+
+	// A resumed solve memorizes the walls known to the saved one
+	if (resuming)
+	{
+		for (int point = 0; point < (int)(Width * Height); point++)
+		{
+			for (unsigned int i = 0; i < Topology::Directions; i++)
+			{
+				int adjacent = GetAdjacent(i, point, false);
+				if (adjacent > point && IsClosed(adjacent, point))
+					Memorize(obstacles, Obstacle(point, adjacent));
+			}
+		}
+	}
+
 	int previousPoint = CurrentPoint;
 
-	Stack<int> path;
-	while (GetShortestPath(CurrentPoint, obstacles, path))
+	ScanPolicy policy = scanPolicy;
+	if (policy == ScanPolicy::CostBased)
+	{
+		// A wall found beside the path spares at least a move towards it and back,
+		// the points beside the path are not scanned when the scan costs more than that
+		if (costModel.ScanCost <= 2 * costModel.MoveCost + costModel.TurnCost)
+			policy = ScanPolicy::Everything;
+		else
+			policy = ScanPolicy::PathOnly;
+	}
+
+	// The contingency path replaces the search when the wall it was searched for is found
+	Path* path = &plannedPath;
+	Path* contingency = &contingencyPath;
+	bool contingencyFound = false;
+	bool prepared = false;
+
+	// A solve started or resumed at the exit has nothing to plan
+	if (CurrentPoint == EndPoint)
+		return true;
+
+	while (!IsInterrupted() && (prepared || Plan(CurrentPoint, obstacles, *path)))
 	{
+		MAZESOLVER_TRACE_SCOPE("Follow path");
+
+		prepared = false;
+		contingencyFound = false;
+
 		bool pathIsBlocked = false;
 		do
 		{
 			if (CurrentPoint == EndPoint) // Reached the end
 				return true;
 
-			// 4 possible directions
-			for (unsigned int i = 0; i < 4; i++)
+			// Every possible direction
+			for (unsigned int i = 0; i < Topology::Directions; i++)
 			{
 				int adjacent = GetAdjacent(i);
 
@@ -44,6 +94,16 @@ bool MazeSolver::Solver::PeriodicCorrectionSolution()
 				if (adjacent == previousPoint)
 					continue;
 
+				if (adjacent != path->Peek())
+				{
+					if (policy == ScanPolicy::PathOnly)
+						continue;
+
+					// The points towards the exit are the ones the next searches would try to go through
+					if (policy == ScanPolicy::Opportunistic && Topology::GetDistance(adjacent, EndPoint) >= Topology::GetDistance(CurrentPoint, EndPoint))
+						continue;
+				}
+
 				// Skip if we already know there's an obstacle
 				bool obstacleMemorized = false;
 				for (Obstacle& obstacle : obstacles)
@@ -57,22 +117,77 @@ bool MazeSolver::Solver::PeriodicCorrectionSolution()
 				}
 
 				if (obstacleMemorized)
+				{
+					// A range scan from elsewhere found the wall after the path was searched
+					if (adjacent == path->Peek())
+						pathIsBlocked = true;
+
+					continue;
+				}
+
+				// Skip if we already know there's a path
+				if (IsOpen(adjacent, CurrentPoint))
 					continue;
 
+				if (!CanScan())
+					return false;
+
 				if (!IsAccessible(adjacent))
 				{
-					obstacles.Push(Obstacle(adjacent, CurrentPoint));
+					Memorize(obstacles, Obstacle(adjacent, CurrentPoint));
 
 					// Path is blocked if there's an obstacle in front of the next point in the calculated path
-					if (adjacent == path.Peek())
+					if (adjacent == path->Peek())
 						pathIsBlocked = true;
 				}
 			}
 
+			// A range scan can find a wall further along the path, the path is searched again before the runner gets there
+			if (!pathIsBlocked && rangeScanFunction != nullptr && IsBlockedAhead(*path))
+			{
+				pathIsBlocked = true;
+				contingencyFound = false;
+			}
+
 			if (!pathIsBlocked)
 			{
+				if (!CanMove())
+					return false;
+
 				previousPoint = CurrentPoint;
-				Move(path.Pop());
+				Move(path->Pop());
+
+				// The hierarchical planner refines the path one segment at a time
+				if (path->IsEmpty() && CurrentPoint != EndPoint)
+					break;
+
+				if (CurrentPoint != EndPoint)
+					contingencyFound = PlanContingency(obstacles, path->Peek(), *contingency);
+			}
+			else if (contingencyFound)
+			{
+				// The other walls found by the scans are around the runner, the contingency path stays
+				// the shortest one unless its first move is behind one of them
+				bool firstMoveBlocked = false;
+				for (Obstacle& obstacle : obstacles)
+				{
+					if ((contingency->Peek() == obstacle.First && CurrentPoint == obstacle.Second) ||
+						(contingency->Peek() == obstacle.Second && CurrentPoint == obstacle.First))
+					{
+						firstMoveBlocked = true;
+						break;
+					}
+				}
+
+				if (!firstMoveBlocked)
+				{
+					Path* temp = path;
+					path = contingency;
+					contingency = temp;
+
+					prepared = true;
+					report.ContingencyHits++;
+				}
 			}
 		}
 		while (!pathIsBlocked);
@@ -0,0 +1,124 @@
+#include "plancache.h"
+
+MazeSolver::PlanCache::PlanCache()
+{
+	Clear();
+}
+
+unsigned long long MazeSolver::PlanCache::GetWallKey(unsigned int edge)
+{
+	// The keys are mixed from the identifiers instead of being kept in a table,
+	// so every cache and every solver agrees on them without storing one per edge
+	unsigned long long key = edge + 0x9E3779B97F4A7C15ULL;
+	key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	key = (key ^ (key >> 27)) * 0x94D049BB133111EBULL;
+
+	return key ^ (key >> 31);
+}
+
+bool MazeSolver::PlanCache::Find(int initialPoint, int endPoint, unsigned long long wallHash, bool& found, Path& path)
+{
+	int entry = buckets[GetBucket(initialPoint, endPoint, wallHash)];
+	while (entry != -1)
+	{
+		Entry& candidate = entries[entry];
+		if (candidate.InitialPoint == initialPoint && candidate.EndPoint == endPoint && candidate.WallHash == wallHash)
+		{
+			// The entry becomes the most recently used one
+			Unlink(entry);
+			Link(entry);
+
+			found = candidate.Found;
+			path = candidate.Points;
+			return true;
+		}
+
+		entry = candidate.Next;
+	}
+
+	return false;
+}
+
+void MazeSolver::PlanCache::Add(int initialPoint, int endPoint, unsigned long long wallHash, bool found, Path& path)
+{
+	int entry;
+	if (count < Capacity)
+	{
+		entry = count++;
+	}
+	else
+	{
+		// The least recently used entry is reused
+		entry = oldest;
+		Unlink(entry);
+
+		Entry& old = entries[entry];
+		int* next = &buckets[GetBucket(old.InitialPoint, old.EndPoint, old.WallHash)];
+		while (*next != entry)
+			next = &entries[*next].Next;
+
+		*next = old.Next;
+	}
+
+	Entry& added = entries[entry];
+	added.InitialPoint = initialPoint;
+	added.EndPoint = endPoint;
+	added.WallHash = wallHash;
+	added.Found = found;
+	added.Points = path;
+
+	unsigned int bucket = GetBucket(initialPoint, endPoint, wallHash);
+	added.Next = buckets[bucket];
+	buckets[bucket] = entry;
+
+	Link(entry);
+}
+
+void MazeSolver::PlanCache::Clear()
+{
+	for (unsigned int i = 0; i < Buckets; i++)
+		buckets[i] = -1;
+
+	count = 0;
+	newest = -1;
+	oldest = -1;
+}
+
+unsigned int MazeSolver::PlanCache::GetBucket(int initialPoint, int endPoint, unsigned long long wallHash)
+{
+	// The hash of the walls is random already, the points only have to be spread over it
+	unsigned long long key = wallHash ^ (initialPoint * 0x9E3779B97F4A7C15ULL) ^ (endPoint * 0xC2B2AE3D27D4EB4FULL);
+	key ^= key >> 32;
+
+	return (unsigned int)(key % Buckets);
+}
+
+void MazeSolver::PlanCache::Unlink(int entry)
+{
+	Entry& unlinked = entries[entry];
+
+	if (unlinked.Newer != -1)
+		entries[unlinked.Newer].Older = unlinked.Older;
+	else
+		newest = unlinked.Older;
+
+	if (unlinked.Older != -1)
+		entries[unlinked.Older].Newer = unlinked.Newer;
+	else
+		oldest = unlinked.Newer;
+}
+
+void MazeSolver::PlanCache::Link(int entry)
+{
+	Entry& linked = entries[entry];
+
+	linked.Newer = -1;
+	linked.Older = newest;
+
+	if (newest != -1)
+		entries[newest].Newer = entry;
+	else
+		oldest = entry;
+
+	newest = entry;
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "config.h"
+
+#include "containers.h"
+
+namespace MazeSolver
+{
+
+	// Remembers the results of the searches by their start, exit and known walls, the least recently used one is forgotten first.
+	// The walls are told apart by a Zobrist hash, so the same cache can be shared by the solvers of the same layouts,
+	// though not by several threads at once
+	class PlanCache
+	{
+
+	public:
+		// The number of remembered searches
+		static const unsigned int Capacity = MAZESOLVER_PLAN_CACHE_SIZE;
+
+		// Each bucket lists the searches whose keys fall into it
+		static const unsigned int Buckets = 2 * Capacity;
+
+	public:
+		/// <summary>
+		/// Constructor.
+		/// </summary>
+		PlanCache();
+
+		/// <summary>
+		/// Gets the random key of a wall, the hash of the walls is the exclusive or of their keys.
+		/// </summary>
+		/// <param name="edge">The identifier of the edge of the wall.</param>
+		/// <returns>The key.</returns>
+		static unsigned long long GetWallKey(unsigned int edge);
+
+		/// <summary>
+		/// Looks up a search.
+		/// </summary>
+		/// <param name="initialPoint">The starting point.</param>
+		/// <param name="endPoint">The exit point.</param>
+		/// <param name="wallHash">The hash of the known walls.</param>
+		/// <param name="found">A place to store whether the exit was reachable.</param>
+		/// <param name="path">A place to store the path.</param>
+		/// <returns>True if the search is remembered, false otherwise.</returns>
+		bool Find(int initialPoint, int endPoint, unsigned long long wallHash, bool& found, Path& path);
+
+		/// <summary>
+		/// Remembers a search, the least recently used one is forgotten if the cache is full.
+		/// </summary>
+		/// <param name="initialPoint">The starting point.</param>
+		/// <param name="endPoint">The exit point.</param>
+		/// <param name="wallHash">The hash of the known walls.</param>
+		/// <param name="found">Whether the exit was reachable.</param>
+		/// <param name="path">The path.</param>
+		void Add(int initialPoint, int endPoint, unsigned long long wallHash, bool found, Path& path);
+
+		/// <summary>
+		/// Forgets every search.
+		/// </summary>
+		void Clear();
+
+	private:
+		struct Entry
+		{
+			int InitialPoint;
+			int EndPoint;
+			unsigned long long WallHash;
+
+			bool Found;
+			Path Points;
+
+			// The neighbours in the order of use and the next entry of the same bucket, -1 if none
+			int Newer;
+			int Older;
+			int Next;
+		};
+
+	private:
+		unsigned int GetBucket(int initialPoint, int endPoint, unsigned long long wallHash);
+
+		void Unlink(int entry);
+		void Link(int entry);
+
+	private:
+		Entry entries[Capacity];
+		unsigned int count = 0;
+
+		// The first entry of each bucket, -1 if the bucket is empty
+		int buckets[Buckets];
+
+		int newest = -1;
+		int oldest = -1;
+
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,190 @@
+#include "pruner.h"
+
+#if defined MAZESOLVER_PRUNING
+
+MazeSolver::Pruner::Pruner()
+	: walls(), pruned(), degrees(), pending(), reached()
+{
+	Reset(0, Cells - 1);
+}
+
+void MazeSolver::Pruner::Reset(int currentPoint, int endPoint)
+{
+	this->currentPoint = currentPoint;
+	this->endPoint = endPoint;
+
+	for (unsigned int i = 0; i < sizeof(walls); i++)
+		walls[i] = 0;
+
+	for (unsigned int i = 0; i < sizeof(pruned); i++)
+		pruned[i] = 0;
+
+	// Without walls every adjacent point counts
+	for (unsigned int point = 0; point < Cells; point++)
+	{
+		degrees[point] = 0;
+		for (unsigned int i = 0; i < Topology::Directions; i++)
+		{
+			if (Topology::GetAdjacent(Topology::GetDirection(i), point) != -1)
+				degrees[point]++;
+		}
+	}
+
+	pendingCount = 0;
+	wallsChanged = true;
+	exitReachable = true;
+}
+
+void MazeSolver::Pruner::AddWall(int first, int second)
+{
+	if (IsWall(first, second))
+		return;
+
+	unsigned int edge = Topology::GetEdge(first, second);
+	walls[edge / 8] |= 1 << (edge % 8);
+	wallsChanged = true;
+
+	// A pruned point is not counted by its neighbours already
+	if (IsPruned(first) || IsPruned(second))
+		return;
+
+	Decrease(first);
+	Decrease(second);
+	Fill();
+}
+
+void MazeSolver::Pruner::SetCurrent(int point)
+{
+	int previousPoint = currentPoint;
+	currentPoint = point;
+
+	// The runner could have been standing in a dead end
+	Check(previousPoint);
+	Fill();
+}
+
+bool MazeSolver::Pruner::IsPruned(int point)
+{
+	return (pruned[point / 8] & (1 << (point % 8))) != 0;
+}
+
+bool MazeSolver::Pruner::IsExitReachable()
+{
+	/*
+		let Q be a queue
+
+		Q.Push(exit)
+		while Q is not empty
+			p = Q.Pop()
+			for w in M.AdjacentEdges(p)
+				if w is not reached and there is no wall between p and w
+					label w as reached
+					Q.Push(w)
+		return the runner is reached
+	*/
+
+	if (!wallsChanged)
+		return exitReachable;
+
+	wallsChanged = false;
+
+	// Every pruned point was handled, so the pending points can hold the queue
+#if defined MAZESOLVER_ASSERTS_ALLOWED
+	assert(pendingCount == 0);
+#endif
+
+	for (unsigned int i = 0; i < sizeof(reached); i++)
+		reached[i] = 0;
+
+	unsigned int head = 0;
+	unsigned int tail = 0;
+
+	reached[endPoint / 8] |= 1 << (endPoint % 8);
+	pending[tail++] = endPoint;
+
+	while (head != tail)
+	{
+		int point = pending[head++];
+		if (point == currentPoint)
+			break;
+
+		for (unsigned int i = 0; i < Topology::Directions; i++)
+		{
+			int adjacent = Topology::GetAdjacent(Topology::GetDirection(i), point);
+			if (adjacent == -1 || (reached[adjacent / 8] & (1 << (adjacent % 8))) != 0)
+				continue;
+
+			// The pruned points are searched too, the runner could have backtracked into them
+			if (IsWall(point, adjacent))
+				continue;
+
+			reached[adjacent / 8] |= 1 << (adjacent % 8);
+			pending[tail++] = adjacent;
+		}
+	}
+
+	exitReachable = (reached[currentPoint / 8] & (1 << (currentPoint % 8))) != 0;
+	return exitReachable;
+}
+
+bool MazeSolver::Pruner::IsWall(int first, int second)
+{
+	unsigned int edge = Topology::GetEdge(first, second);
+	return (walls[edge / 8] & (1 << (edge % 8))) != 0;
+}
+
+void MazeSolver::Pruner::Decrease(int point)
+{
+#if defined MAZESOLVER_ASSERTS_ALLOWED
+	assert(degrees[point] > 0);
+#endif
+
+	degrees[point]--;
+	Check(point);
+}
+
+void MazeSolver::Pruner::Check(int point)
+{
+	// The runner and the exit are the ends of every path, so they are never dead ends
+	if (point == currentPoint || point == endPoint || IsPruned(point))
+		return;
+
+	// A point with a single way in can only be entered and left the same way
+	if (degrees[point] > 1)
+		return;
+
+	pruned[point / 8] |= 1 << (point % 8);
+	pending[pendingCount++] = point;
+}
+
+void MazeSolver::Pruner::Fill()
+{
+	/*
+		let S be a stack of the pruned points
+
+		while S is not empty
+			p = S.Pop()
+			for w in M.AdjacentEdges(p)
+				if w is not pruned and there is no wall between p and w
+					w.Degree--
+					if w.Degree <= 1 and w is not the runner or the exit
+						label w as pruned
+						S.Push(w)
+	*/
+
+	while (pendingCount != 0)
+	{
+		int point = pending[--pendingCount];
+
+		for (unsigned int i = 0; i < Topology::Directions; i++)
+		{
+			int adjacent = Topology::GetAdjacent(Topology::GetDirection(i), point);
+			if (adjacent == -1 || IsPruned(adjacent) || IsWall(point, adjacent))
+				continue;
+
+			Decrease(adjacent);
+		}
+	}
+}
+
+#endif
\ No newline at end of file
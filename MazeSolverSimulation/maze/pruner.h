@@ -0,0 +1,100 @@
+#pragma once
+
+#include "config.h"
+
+#if defined MAZESOLVER_PRUNING
+
+#if defined MAZESOLVER_ASSERTS_ALLOWED
+#include <cassert>
+#endif
+
+#include "topology.h"
+
+namespace MazeSolver
+{
+
+	// Finds the points that cannot be on a path from the runner to the exit from the known walls,
+	// every edge that is not known to be a wall is treated as open
+	class Pruner
+	{
+
+	public:
+		// The dimensions of the maze
+		static const unsigned int Width = MAZESOLVER_WIDTH;
+		static const unsigned int Height = MAZESOLVER_HEIGHT;
+		static const unsigned int Cells = Width * Height;
+
+	public:
+		/// <summary>
+		/// Constructor.
+		/// </summary>
+		Pruner();
+
+		/// <summary>
+		/// Forgets the walls and the pruned points.
+		/// </summary>
+		/// <param name="currentPoint">The point of the runner.</param>
+		/// <param name="endPoint">The exit point.</param>
+		void Reset(int currentPoint, int endPoint);
+
+		/// <summary>
+		/// Adds a wall, the dead ends it creates are pruned.
+		/// </summary>
+		/// <param name="first">The first point.</param>
+		/// <param name="second">The second point.</param>
+		void AddWall(int first, int second);
+
+		/// <summary>
+		/// Moves the runner, the point it left is pruned if it's a dead end.
+		/// </summary>
+		/// <param name="point">The new point of the runner.</param>
+		void SetCurrent(int point);
+
+		/// <summary>
+		/// Checks whether a point is pruned.
+		/// </summary>
+		/// <param name="point">The point to check.</param>
+		/// <returns>True if the point cannot be on a path from the runner to the exit, false otherwise.</returns>
+		bool IsPruned(int point);
+
+		/// <summary>
+		/// Checks whether the known walls leave a path from the runner to the exit.
+		/// </summary>
+		/// <returns>False if the runner is enclosed, true otherwise.</returns>
+		bool IsExitReachable();
+
+	private:
+		bool IsWall(int first, int second);
+
+		void Decrease(int point);
+		void Check(int point);
+		void Fill();
+
+	private:
+		// The known walls, one bit per edge of the topology
+		unsigned char walls[(Topology::Edges + 7) / 8];
+
+		// The pruned points, one bit per point
+		unsigned char pruned[(Cells + 7) / 8];
+
+		// The number of adjacent points that are not pruned and not behind a wall
+		unsigned char degrees[Cells];
+
+		// The pruned points whose neighbours are not updated yet,
+		// the same array is the queue of the search for the exit
+		int pending[Cells];
+		unsigned int pendingCount = 0;
+
+		// The points reached from the exit by the last search
+		unsigned char reached[(Cells + 7) / 8];
+		bool wallsChanged = true;
+		bool exitReachable = true;
+
+		int currentPoint = 0;
+		int endPoint = Cells - 1;
+
+	};
+
+}
+
+#endif
\ No newline at end of file
@@ -6,7 +6,7 @@ namespace MazeSolver
 {
 
 	// This class hides an implementation of the queue
-	template<typename T>
+	template<typename T, typename Implementation = List<T>>
 	class Queue
 	{
 
@@ -19,7 +19,7 @@ namespace MazeSolver
 		/// <summary>
 		/// Constructor from a list.
 		/// </summary>
-		Queue(List<T> other)
+		Queue(Implementation other)
 			: list(other) {}
 
 		/// <summary>
@@ -31,6 +31,14 @@ namespace MazeSolver
 			return list.IsEmpty();
 		}
 
+		/// <summary>
+		/// Removes all values from the queue.
+		/// </summary>
+		void Clear()
+		{
+			list.Clear();
+		}
+
 		/// <summary>
 		/// Push a value to the queue.
 		/// </summary>
@@ -62,14 +70,14 @@ namespace MazeSolver
 		/// Converts the queue to a list.
 		/// </summary>
 		/// <returns>A list.</returns>
-		List<T>& ToList()
+		Implementation& ToList()
 		{
 			return list;
 		}
 
 	private:
 		// The implementation
-		List<T> list;
+		Implementation list;
 		// std::queue<T> queue;
 
 	};
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "config.h"
+
+#include "topology.h"
+
+namespace MazeSolver
+{
+
+	/// <summary>
+	/// A function type for the scan function with signature:
+	/// bool Scan(int point)
+	/// </summary>
+	/// <param>The direction of the point to scan.</param>
+	/// <returns>True if there is direct path to the point, false otherwise.</returns>
+	using ScanFunction = bool (*)(Direction);
+
+	/// <summary>
+	/// A function type for the range scan function with signature:
+	/// unsigned int RangeScan(Direction direction)
+	/// </summary>
+	/// <param>The direction of the ray from the runner.</param>
+	/// <returns>The number of points the runner can go to straight along the ray before a wall or the border of the maze.</returns>
+	using RangeScanFunction = unsigned int (*)(Direction);
+
+	/// <summary>
+	/// A function type for the goal detection function with signature:
+	/// bool IsGoal()
+	/// </summary>
+	/// <returns>True if the runner stands on the goal, false otherwise.</returns>
+	using GoalFunction = bool (*)();
+
+}
\ No newline at end of file
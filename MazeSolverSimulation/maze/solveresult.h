@@ -0,0 +1,62 @@
+#pragma once
+
+namespace MazeSolver
+{
+
+	/// <summary>
+	/// A function type for the cancellation function with signature:
+	/// bool Cancel()
+	/// </summary>
+	/// <returns>True if the solve should stop, false otherwise.</returns>
+	using CancelFunction = bool (*)();
+
+	enum class SolveStatus : unsigned char
+	{
+		Solved,
+		Unreachable,
+		MoveLimit,
+		ScanLimit,
+		TimeLimit,
+		Cancelled,
+		// The wall follower looped without the Tremaux marks, whether the exit is reachable is not known
+		GaveUp,
+		// The file of the tiled storage could not be opened or one of its tiles could not be mapped
+		StorageFailed
+	};
+
+	// The limits of a single solve, 0 if not limited
+	struct Limits
+	{
+		unsigned int MaxMoves = 0;
+		unsigned int MaxScans = 0;
+
+		// The longest time of the solve in milliseconds, measured with the clock of the cost model, which has to be set
+		double MaxTime = 0;
+
+		// Checked by the solutions between the scans and the moves
+		CancelFunction Cancel = nullptr;
+	};
+
+	struct SolveResult
+	{
+		SolveStatus Status = SolveStatus::Unreachable;
+
+		// The points the runner has been to
+		unsigned int ExploredPoints = 0;
+
+		// The explored point closest to the exit and its distance to the exit,
+		// counted as if there were no walls
+		int ClosestPoint = 0;
+		unsigned int ClosestDistance = 0;
+
+		/// <summary>
+		/// Checks whether the maze is solved.
+		/// </summary>
+		/// <returns>True if the maze is solved, false otherwise.</returns>
+		operator bool() const
+		{
+			return Status == SolveStatus::Solved;
+		}
+	};
+
+}
\ No newline at end of file
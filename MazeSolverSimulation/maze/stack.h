@@ -6,7 +6,7 @@ namespace MazeSolver
 {
 
 	// This class hides an implementation of the stack
-	template<typename T>
+	template<typename T, typename Implementation = List<T>>
 	class Stack
 	{
 
@@ -19,13 +19,13 @@ namespace MazeSolver
 		/// <summary>
 		/// Constructor from a stack.
 		/// </summary>
-		Stack(Stack<T>& other)
+		Stack(Stack<T, Implementation>& other)
 			: list(other.list) {}
 
 		/// <summary>
 		/// Constructor from a list.
 		/// </summary>
-		Stack(List<T>& other)
+		Stack(Implementation& other)
 			: list(other) {}
 
 		/// <summary>
@@ -33,7 +33,7 @@ namespace MazeSolver
 		/// </summary>
 		/// <param name="other">The stack to copy to this stack.</param>
 		/// <returns>This stack.</returns>
-		Stack<T>& operator=(const Stack<T>& other)
+		Stack<T, Implementation>& operator=(const Stack<T, Implementation>& other)
 		{
 			list = other.list;
 
@@ -49,6 +49,14 @@ namespace MazeSolver
 			return list.IsEmpty();
 		}
 
+		/// <summary>
+		/// Removes all values from the stack.
+		/// </summary>
+		void Clear()
+		{
+			list.Clear();
+		}
+
 		/// <summary>
 		/// Push a value on to the stack.
 		/// </summary>
@@ -80,14 +88,14 @@ namespace MazeSolver
 		/// Converts the stack to a list.
 		/// </summary>
 		/// <returns>A list.</returns>
-		List<T> &ToList()
+		Implementation &ToList()
 		{
 			return list;
 		}
 
 	private:
 		// The implementation
-		List<T> list;
+		Implementation list;
 		// std::stack<T> stack;
 
 	};
@@ -0,0 +1,75 @@
+#include "standalonefollower.h"
+
+MazeSolver::StandaloneFollower::StandaloneFollower(ScanFunction scanFunction, MovementFunction moveFunction)
+	: scanFunction(scanFunction), moveFunction(moveFunction)
+{
+}
+
+MazeSolver::SolveStatus MazeSolver::StandaloneFollower::Solve()
+{
+	heading = Direction::Invalid;
+
+	return WallFollower<StandaloneFollower>::Solve(*this);
+}
+
+bool MazeSolver::StandaloneFollower::FindAccessible(const int* points, unsigned int count, unsigned int& index)
+{
+	// Nothing is remembered, so every edge is scanned again
+	for (index = 0; index < count; index++)
+	{
+		if (scanFunction(Topology::GetDirection(points[index], CurrentPoint)))
+			return true;
+	}
+
+	return true;
+}
+
+bool MazeSolver::StandaloneFollower::CanMove()
+{
+	// There are no limits
+	return true;
+}
+
+unsigned int MazeSolver::StandaloneFollower::GetMarks(int point, int currentPoint)
+{
+#if !defined MAZESOLVER_NO_TREMAUX_MARKS
+	unsigned int edge = Topology::GetEdge(point, currentPoint);
+	return (tremauxMarks[edge / 4] >> (edge % 4 * 2)) & 3;
+#else
+	(void)point;
+	(void)currentPoint;
+	return 0;
+#endif
+}
+
+void MazeSolver::StandaloneFollower::Mark(int point, int currentPoint)
+{
+#if !defined MAZESOLVER_NO_TREMAUX_MARKS
+	// An edge is never gone along more than twice
+	if (GetMarks(point, currentPoint) == 2)
+		return;
+
+	unsigned int edge = Topology::GetEdge(point, currentPoint);
+	tremauxMarks[edge / 4] += 1 << (edge % 4 * 2);
+#else
+	(void)point;
+	(void)currentPoint;
+#endif
+}
+
+void MazeSolver::StandaloneFollower::ClearMarks()
+{
+#if !defined MAZESOLVER_NO_TREMAUX_MARKS
+	for (unsigned int i = 0; i < sizeof(tremauxMarks); i++)
+		tremauxMarks[i] = 0;
+#endif
+}
+
+void MazeSolver::StandaloneFollower::Move(int point)
+{
+	Direction direction = Topology::GetDirection(point, CurrentPoint);
+
+	heading = direction;
+	moveFunction(direction);
+	CurrentPoint = point;
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "config.h"
+
+#include "actuator.h"
+#include "sensors.h"
+#include "solveresult.h"
+#include "topology.h"
+#include "wallfollower.h"
+
+namespace MazeSolver
+{
+
+	// The wall follower of the solver without the solver, for the boards without memory for the known points and edges
+	// and the planners. It scans every edge it needs again instead of remembering it, and it has no limits and no report
+	class StandaloneFollower
+	{
+
+	public:
+		// The dimensions of the maze are constant
+		static const unsigned int Width = MAZESOLVER_WIDTH;
+		static const unsigned int Height = MAZESOLVER_HEIGHT;
+
+		// The index of the start point
+		const int StartPoint = 0;
+
+		// The index of the exit point
+		const int EndPoint = Width * Height - 1;
+
+	private:
+		ScanFunction scanFunction;
+		MovementFunction moveFunction;
+
+		// The direction of the last move, turning is counted against it
+		Direction heading = Direction::Invalid;
+
+#if !defined MAZESOLVER_NO_TREMAUX_MARKS
+		// The times the runner went along every edge after it looped, 2 bits per edge
+		unsigned char tremauxMarks[(Topology::Edges + 3) / 4];
+#endif
+
+	public:
+		// The index of the current point
+		int CurrentPoint = StartPoint;
+
+		/// <summary>
+		/// Constructor.
+		/// </summary>
+		/// <param name="scanFunction">Function that tells the runner whether there is a direct path to a point.</param>
+		/// <param name="moveFunction">Function that provides movement between adjacent cells.</param>
+		StandaloneFollower(ScanFunction scanFunction, MovementFunction moveFunction);
+
+		/// <summary>
+		/// Solves the maze by following the walls from the current point, the same way as the wall follower solution of the solver.
+		/// </summary>
+		/// <returns>Solved, Unreachable if the runner is walled in or explored every edge it can get to,
+		/// or GaveUp if it looped without the Tremaux marks.</returns>
+		SolveStatus Solve();
+
+	private:
+		// The wall follower is shared with the solver, it goes through the follower to scan, move and mark
+		friend class WallFollower<StandaloneFollower>;
+
+		bool FindAccessible(const int* points, unsigned int count, unsigned int& index);
+		bool CanMove();
+
+		unsigned int GetMarks(int point, int currentPoint);
+		void Mark(int point, int currentPoint);
+		void ClearMarks();
+
+		void Move(int point);
+
+	};
+
+}
\ No newline at end of file
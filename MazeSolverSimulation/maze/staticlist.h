@@ -0,0 +1,169 @@
+#pragma once
+
+#include "config.h"
+
+#if defined MAZESOLVER_ASSERTS_ALLOWED
+#include <cassert>
+#endif
+
+#include "list.h"
+
+namespace MazeSolver
+{
+
+	// This class hides an implementation of the list with a fixed capacity that never allocates
+	template<typename T, unsigned int N>
+	class StaticList
+	{
+
+	public:
+		using ValueType = T;
+		using Iterator = ListIterator<StaticList<T, N>>;
+
+		static const unsigned int Capacity = N;
+
+	public:
+		/// <summary>
+		/// Constructor.
+		/// </summary>
+		StaticList()
+		{
+			head = 0;
+			size = 0;
+		}
+
+		/// <summary>
+		/// Gets the list size.
+		/// </summary>
+		/// <returns>The size of the list.</returns>
+		int Size()
+		{
+			return size;
+		}
+
+		/// <summary>
+		/// Checks whether the list is empty.
+		/// </summary>
+		/// <returns>True if empty, false otherwise.</returns>
+		bool IsEmpty()
+		{
+			return size == 0;
+		}
+
+		/// <summary>
+		/// Removes all values from the list.
+		/// </summary>
+		void Clear()
+		{
+			head = 0;
+			size = 0;
+		}
+
+		/// <summary>
+		/// Push a value to the list.
+		/// </summary>
+		/// <param name="value">A value to push.</param>
+		void Push(T value)
+		{
+			// The list should never exceed its capacity
+#if defined MAZESOLVER_ASSERTS_ALLOWED
+			assert(size < N);
+#endif
+
+			// Move the values to the front if the dequeued ones left no space at the back
+			if (head + size == N)
+			{
+				for (unsigned int i = 0; i < size; i++)
+					array[i] = array[head + i];
+				head = 0;
+			}
+
+			array[head + size++] = value;
+		}
+
+		/// <summary>
+		/// Peek into the list.
+		/// </summary>
+		/// <returns>A value.</returns>
+		T Peek()
+		{
+			// The stack should be non-empty
+#if defined MAZESOLVER_ASSERTS_ALLOWED
+			assert(!IsEmpty());
+#endif
+
+			return array[head + size - 1];
+		}
+
+		/// <summary>
+		/// Pop a value from the list.
+		/// </summary>
+		/// <returns>A popped value.</returns>
+		T Pop()
+		{
+			// The stack should be non-empty
+#if defined MAZESOLVER_ASSERTS_ALLOWED
+			assert(!IsEmpty());
+#endif
+
+			size--;
+			return array[head + size];
+		}
+
+		/// <summary>
+		/// Peek into the front of the list.
+		/// </summary>
+		/// <returns>A value.</returns>
+		T PeekFront()
+		{
+			// The stack should be non-empty
+#if defined MAZESOLVER_ASSERTS_ALLOWED
+			assert(!IsEmpty());
+#endif
+
+			return array[head];
+		}
+
+		/// <summary>
+		/// Dequeue a value from the list.
+		/// </summary>
+		/// <returns>A dequeued value.</returns>
+		T Dequeue()
+		{
+			// The stack should be non-empty
+#if defined MAZESOLVER_ASSERTS_ALLOWED
+			assert(!IsEmpty());
+#endif
+
+			// The front only moves forward, so dequeuing does not shift the values
+			T value = array[head];
+			head++;
+			size--;
+
+			if (size == 0)
+				head = 0;
+
+			return value;
+		}
+
+		// Iterating
+		Iterator begin()
+		{
+			return Iterator(array + head);
+		}
+
+		Iterator end()
+		{
+			return Iterator(array + head + size);
+		}
+
+	private:
+		// The implementation
+		T array[N];
+
+		unsigned int head;
+		unsigned int size;
+
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,321 @@
+#include "tilestore.h"
+
+#if defined _WIN32
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+MazeSolver::TileStore::TileStore()
+	: layerOffsets(), views(), viewTiles(), viewUses(), generations()
+{
+	for (CellId i = 0; i < TileCount; i++)
+		slots[i] = -1;
+
+	// The layers follow each other in a tile
+	for (unsigned int i = 0; i < LayerCount; i++)
+	{
+		layerOffsets[i + 1] = layerOffsets[i] + (CellsPerTile * GetBits((Layer)i) + 7) / 8;
+		generation[i] = 1;
+	}
+}
+
+MazeSolver::TileStore::~TileStore()
+{
+	Close();
+}
+
+bool MazeSolver::TileStore::Open(const char* path)
+{
+	Close();
+
+	// Nothing in the file is known to be stored by this store
+	for (unsigned int i = 0; i < LayerCount; i++)
+		Clear((Layer)i);
+
+	// The offset of every mapping has to be aligned
+	CellId granularity;
+#if defined _WIN32
+	SYSTEM_INFO systemInfo;
+	GetSystemInfo(&systemInfo);
+	granularity = systemInfo.dwAllocationGranularity;
+#else
+	granularity = sysconf(_SC_PAGESIZE);
+#endif
+
+	tileBytes = (layerOffsets[LayerCount] + granularity - 1) / granularity * granularity;
+	CellId fileBytes = tileBytes * TileCount;
+
+#if defined _WIN32
+	HANDLE fileHandle;
+	if (path == nullptr)
+	{
+		char directory[MAX_PATH];
+		char temporaryPath[MAX_PATH];
+		if (GetTempPathA(MAX_PATH, directory) == 0 || GetTempFileNameA(directory, "msv", 0, temporaryPath) == 0)
+			return false;
+
+		fileHandle = CreateFileA(temporaryPath, GENERIC_READ | GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, NULL);
+	}
+	else
+	{
+		fileHandle = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, 0, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	}
+
+	if (fileHandle == INVALID_HANDLE_VALUE)
+		return false;
+
+	HANDLE mappingHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READWRITE, (DWORD)(fileBytes >> 32), (DWORD)fileBytes, NULL);
+	if (mappingHandle == NULL)
+	{
+		CloseHandle(fileHandle);
+		return false;
+	}
+
+	file = fileHandle;
+	mapping = mappingHandle;
+#else
+	if (path == nullptr)
+	{
+		char temporaryPath[] = "/tmp/mazesolver-XXXXXX";
+		descriptor = mkstemp(temporaryPath);
+
+		// The file is deleted when the descriptor is closed
+		if (descriptor != -1)
+			unlink(temporaryPath);
+	}
+	else
+	{
+		descriptor = open(path, O_RDWR | O_CREAT, 0644);
+	}
+
+	if (descriptor == -1)
+		return false;
+
+	if (ftruncate(descriptor, fileBytes) != 0)
+	{
+		close(descriptor);
+		descriptor = -1;
+		return false;
+	}
+#endif
+
+	// The file may not support the mappings, which is found out before anything is stored
+	usable = true;
+	if (GetTile(0) == nullptr)
+	{
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+void MazeSolver::TileStore::Close()
+{
+	for (unsigned int i = 0; i < ResidentTiles; i++)
+		Unmap(i);
+
+	lastTile = TileCount;
+	lastView = nullptr;
+
+	usable = false;
+
+#if defined _WIN32
+	if (mapping != nullptr)
+	{
+		CloseHandle(mapping);
+		mapping = nullptr;
+	}
+
+	if (file != nullptr)
+	{
+		CloseHandle(file);
+		file = nullptr;
+	}
+#else
+	if (descriptor != -1)
+	{
+		close(descriptor);
+		descriptor = -1;
+	}
+#endif
+}
+
+bool MazeSolver::TileStore::IsUsable()
+{
+	return usable;
+}
+
+unsigned int MazeSolver::TileStore::Get(Layer layer, CellId cell)
+{
+	CellId tile = GetTileOf(cell);
+
+	// A tile that has not been touched since the last clear of the layer does not have to be paged in
+	if (generations[(unsigned int)layer][tile] != generation[(unsigned int)layer])
+		return 0;
+
+	unsigned char* view = GetTile(tile);
+	if (view == nullptr)
+		return 0;
+
+	unsigned int bits = GetBits(layer);
+	CellId position = GetOffsetOf(cell) * bits;
+	unsigned char* fields = view + layerOffsets[(unsigned int)layer];
+
+	return (fields[position / 8] >> (position % 8)) & ((1 << bits) - 1);
+}
+
+void MazeSolver::TileStore::Set(Layer layer, CellId cell, unsigned int value)
+{
+	CellId tile = GetTileOf(cell);
+	unsigned char* view = GetTile(tile);
+	if (view == nullptr)
+		return;
+
+	unsigned char* fields = view + layerOffsets[(unsigned int)layer];
+
+	unsigned int bits = GetBits(layer);
+	if (generations[(unsigned int)layer][tile] != generation[(unsigned int)layer])
+	{
+		for (CellId i = 0; i < (CellsPerTile * bits + 7) / 8; i++)
+			fields[i] = 0;
+
+		generations[(unsigned int)layer][tile] = generation[(unsigned int)layer];
+	}
+
+	// The fields are 1, 2 or 4 bits wide, so a field never crosses a byte
+	CellId position = GetOffsetOf(cell) * bits;
+	unsigned int mask = ((1 << bits) - 1) << (position % 8);
+	fields[position / 8] = (unsigned char)((fields[position / 8] & ~mask) | ((value << (position % 8)) & mask));
+}
+
+void MazeSolver::TileStore::Clear(Layer layer)
+{
+	unsigned int index = (unsigned int)layer;
+	generation[index]++;
+
+	// The generation wrapped around, the stamps have to be reset
+	if (generation[index] == 0)
+	{
+		for (CellId i = 0; i < TileCount; i++)
+			generations[index][i] = 0;
+
+		generation[index] = 1;
+	}
+}
+
+unsigned char* MazeSolver::TileStore::GetTile(CellId tile)
+{
+#if defined MAZESOLVER_ASSERTS_ALLOWED
+	assert(tile < TileCount);
+#endif
+
+	if (tile == lastTile)
+		return lastView;
+
+	int slot = slots[tile];
+	if (slot == -1)
+	{
+		// Evict the least recently used tile
+		slot = 0;
+		for (unsigned int i = 1; i < ResidentTiles; i++)
+		{
+			if (viewUses[i] < viewUses[slot])
+				slot = i;
+		}
+
+		Unmap(slot);
+
+#if defined _WIN32
+		CellId offset = tile * tileBytes;
+		void* view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, (DWORD)(offset >> 32), (DWORD)offset, (SIZE_T)tileBytes);
+		if (view == NULL)
+			view = nullptr;
+#else
+		void* view = mmap(nullptr, tileBytes, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, tile * tileBytes);
+		if (view == MAP_FAILED)
+			view = nullptr;
+#endif
+
+		// The tile could not be mapped, the store stops being usable
+		if (view == nullptr)
+		{
+			usable = false;
+			return nullptr;
+		}
+
+		views[slot] = (unsigned char*)view;
+		viewTiles[slot] = tile;
+		slots[tile] = slot;
+	}
+
+	viewUses[slot] = ++uses;
+
+	lastTile = tile;
+	lastView = views[slot];
+
+	return lastView;
+}
+
+void MazeSolver::TileStore::Unmap(unsigned int slot)
+{
+	if (views[slot] == nullptr)
+		return;
+
+#if defined _WIN32
+	UnmapViewOfFile(views[slot]);
+#else
+	munmap(views[slot], tileBytes);
+#endif
+
+	if (lastView == views[slot])
+	{
+		lastTile = TileCount;
+		lastView = nullptr;
+	}
+
+	slots[viewTiles[slot]] = -1;
+	views[slot] = nullptr;
+	viewUses[slot] = 0;
+}
+
+MazeSolver::CellId MazeSolver::TileStore::GetTileOf(CellId cell)
+{
+	CellId x = cell % Width;
+	CellId y = cell / Width;
+
+	return (y / TileSize) * TilesX + x / TileSize;
+}
+
+MazeSolver::CellId MazeSolver::TileStore::GetOffsetOf(CellId cell)
+{
+	CellId x = cell % Width;
+	CellId y = cell / Width;
+
+	return (y % TileSize) * TileSize + x % TileSize;
+}
+
+unsigned int MazeSolver::TileStore::GetBits(Layer layer)
+{
+	switch (layer)
+	{
+	case Layer::Visited:
+	case Layer::Discovered:
+	case Layer::Remembered:
+		return 1;
+	case Layer::Parent:
+	case Layer::OpenEdges:
+	case Layer::ClosedEdges:
+		return 2;
+	case Layer::Marks:
+		return 4;
+	}
+
+	// Code should never be able to get here
+	return 0;
+}
\ No newline at end of file
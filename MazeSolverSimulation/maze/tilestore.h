@@ -0,0 +1,161 @@
+#pragma once
+
+#include "config.h"
+
+#if defined MAZESOLVER_ASSERTS_ALLOWED
+#include <cassert>
+#endif
+
+namespace MazeSolver
+{
+
+	/// <summary>
+	/// A 64-bit index of a point in row-major order.
+	/// </summary>
+	using CellId = unsigned long long;
+
+	// Stores the state of every point and of the edges to the higher points in square tiles
+	// that are paged in from a memory-mapped file on demand
+	class TileStore
+	{
+
+	public:
+		// The kinds of the state, every one is a field of a few bits per point
+		enum class Layer : unsigned char
+		{
+			// 1 bit, whether the search visited the point
+			Visited,
+
+			// 2 bits, the direction to the parent of the point in the search
+			Parent,
+
+			// 1 bit, whether the runner discovered the point
+			Discovered,
+
+			// 1 bit, whether the runner remembered the point to go to later
+			Remembered,
+
+			// 1 bit for each of the 2 edges to the higher points, whether the edge is known to be open
+			OpenEdges,
+
+			// 1 bit for each of the 2 edges to the higher points, whether the edge is known to be a wall
+			ClosedEdges,
+
+			// 2 bits for each of the 2 edges to the higher points, the times the runner went along the edge
+			Marks
+		};
+
+		static const unsigned int LayerCount = 7;
+
+	public:
+		// The dimensions of the maze
+		static const CellId Width = MAZESOLVER_WIDTH;
+		static const CellId Height = MAZESOLVER_HEIGHT;
+
+		// The maze is stored in square tiles, the points of a tile are stored in row-major order
+		static const CellId TileSize = MAZESOLVER_TILE_SIZE;
+		static const CellId TilesX = (Width + TileSize - 1) / TileSize;
+		static const CellId TilesY = (Height + TileSize - 1) / TileSize;
+		static const CellId TileCount = TilesX * TilesY;
+		static const CellId CellsPerTile = TileSize * TileSize;
+
+		// The number of tiles kept in the memory at once
+		static const unsigned int ResidentTiles = MAZESOLVER_RESIDENT_TILES;
+
+	public:
+		/// <summary>
+		/// Constructor.
+		/// </summary>
+		TileStore();
+
+		/// <summary>
+		/// Destructor.
+		/// </summary>
+		~TileStore();
+
+		/// <summary>
+		/// Opens the file backing the store, the file is created if it does not exist.
+		/// The state stored before is dropped, the tiles of the file are cleared when they are touched.
+		/// </summary>
+		/// <param name="path">The path to the file, or null for a temporary file of this store that is deleted when it is closed.</param>
+		/// <returns>True if the file is opened and its tiles can be mapped, false otherwise.</returns>
+		bool Open(const char* path);
+
+		/// <summary>
+		/// Unmaps all tiles and closes the file.
+		/// </summary>
+		void Close();
+
+		/// <summary>
+		/// Checks whether the store is open and every tile it needed could be mapped.
+		/// A tile that could not be mapped reads as 0 and drops the writes, so the state can no longer be trusted.
+		/// </summary>
+		/// <returns>True if the store can be used, false otherwise.</returns>
+		bool IsUsable();
+
+		/// <summary>
+		/// Gets a field of a point.
+		/// </summary>
+		/// <param name="layer">The kind of the state.</param>
+		/// <param name="cell">The point.</param>
+		/// <returns>The bits of the field.</returns>
+		unsigned int Get(Layer layer, CellId cell);
+
+		/// <summary>
+		/// Sets a field of a point.
+		/// </summary>
+		/// <param name="layer">The kind of the state.</param>
+		/// <param name="cell">The point.</param>
+		/// <param name="value">The bits of the field.</param>
+		void Set(Layer layer, CellId cell, unsigned int value);
+
+		/// <summary>
+		/// Sets a field of every point to 0, the tiles are cleared lazily when they are touched again.
+		/// </summary>
+		/// <param name="layer">The kind of the state.</param>
+		void Clear(Layer layer);
+
+	private:
+		unsigned char* GetTile(CellId tile);
+		void Unmap(unsigned int slot);
+
+		CellId GetTileOf(CellId cell);
+		CellId GetOffsetOf(CellId cell);
+
+		static unsigned int GetBits(Layer layer);
+
+	private:
+		// The offsets of the layers in a tile, followed by the end of the last one
+		CellId layerOffsets[LayerCount + 1];
+
+		// The size of a tile in the file, aligned to the granularity of the mappings
+		CellId tileBytes = 0;
+
+		// The handles of the file
+		int descriptor = -1;
+		void* file = nullptr;
+		void* mapping = nullptr;
+
+		// The tiles mapped into the memory
+		unsigned char* views[ResidentTiles];
+		CellId viewTiles[ResidentTiles];
+		unsigned int viewUses[ResidentTiles];
+		unsigned int uses = 0;
+
+		// The slot of every tile, or -1 if the tile is not in the memory
+		int slots[TileCount];
+
+		// A layer of a tile is valid only if the tile is stamped by the current generation of the layer
+		unsigned int generations[LayerCount][TileCount];
+		unsigned int generation[LayerCount];
+
+		// The last tile used
+		CellId lastTile = TileCount;
+		unsigned char* lastView = nullptr;
+
+		// Whether the store is open and no tile failed to be mapped since
+		bool usable = false;
+
+	};
+
+}
\ No newline at end of file
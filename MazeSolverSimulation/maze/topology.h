@@ -0,0 +1,544 @@
+#pragma once
+
+#include "config.h"
+
+namespace MazeSolver
+{
+
+	enum class Direction : unsigned char
+	{
+		Invalid,
+		Up,
+		Right,
+		Left,
+		Down,
+		UpRight,
+		UpLeft,
+		DownRight,
+		DownLeft
+	};
+
+	// The grid where every point has 4 adjacent points, the default topology
+	template<unsigned int Width, unsigned int Height>
+	class SquareTopology
+	{
+
+	public:
+		// The number of adjacent points
+		static const unsigned int Directions = 4;
+
+		// Every edge is stored by the lower of its points, which has half of the directions towards the higher ones
+		static const unsigned int Edges = Width * Height * Directions / 2;
+
+		/// <summary>
+		/// Gets a direction by its index.
+		/// </summary>
+		/// <param name="index">The index of the direction.</param>
+		/// <returns>The direction.</returns>
+		static Direction GetDirection(unsigned int index)
+		{
+			// Directional preference: Right -> Up -> Left -> Down
+			switch (index)
+			{
+			case 0:
+				return Direction::Right;
+			case 1:
+				return Direction::Up;
+			case 2:
+				return Direction::Left;
+			case 3:
+				return Direction::Down;
+			}
+
+			// Code should never be able to get here
+			return Direction::Invalid;
+		}
+
+		/// <summary>
+		/// Gets the adjacent point in a direction.
+		/// </summary>
+		/// <param name="direction">The direction of the adjacent point.</param>
+		/// <param name="currentPoint">The point to start from.</param>
+		/// <returns>The adjacent point, -1 if it's outside of the maze.</returns>
+		static int GetAdjacent(Direction direction, int currentPoint)
+		{
+			int point;
+			switch (direction)
+			{
+			case Direction::Up:
+				point = currentPoint + Width;
+				if (point >= (int)(Width * Height))
+					return -1;
+
+				return point;
+			case Direction::Right:
+				point = currentPoint + 1;
+				if (point % Width == 0)
+					return -1;
+
+				return point;
+			case Direction::Left:
+				if (currentPoint % Width == 0)
+					return -1;
+
+				point = currentPoint - 1;
+				return point;
+			case Direction::Down:
+				if (currentPoint < (int)Width)
+					return -1;
+
+				point = currentPoint - Width;
+				return point;
+			default:
+				return -1;
+			}
+		}
+
+		/// <summary>
+		/// Gets the direction from a point to an adjacent one.
+		/// </summary>
+		/// <param name="point">The adjacent point.</param>
+		/// <param name="currentPoint">The point to start from.</param>
+		/// <returns>The direction, invalid if the points are not adjacent.</returns>
+		static Direction GetDirection(int point, int currentPoint)
+		{
+			if (point == -1)
+				return Direction::Invalid;
+
+			int difference = point - currentPoint;
+			switch (difference)
+			{
+			case Width:
+				return Direction::Up;
+			case 1:
+				if (point / Width != currentPoint / Width)
+					return Direction::Invalid;
+
+				return Direction::Right;
+			case -1:
+				if (point / Width != currentPoint / Width)
+					return Direction::Invalid;
+
+				return Direction::Left;
+			case -((int)Width):
+				return Direction::Down;
+			default:
+				return Direction::Invalid;
+			}
+		}
+
+		/// <summary>
+		/// Gets the identifier of the edge between two adjacent points.
+		/// </summary>
+		/// <param name="first">The first point.</param>
+		/// <param name="second">The second point.</param>
+		/// <returns>The identifier less than the number of edges.</returns>
+		static unsigned int GetEdge(int first, int second)
+		{
+			if (first > second)
+				return GetEdge(second, first);
+
+			return first * 2 + (second - first == 1 ? 0 : 1);
+		}
+
+		/// <summary>
+		/// Gets the number of the smallest turns between two directions, quarter turns on this grid.
+		/// </summary>
+		/// <param name="from">The direction before turning.</param>
+		/// <param name="to">The direction after turning.</param>
+		/// <returns>The number of turns.</returns>
+		static unsigned int GetTurns(Direction from, Direction to)
+		{
+			if (from == to)
+				return 0;
+
+			// The opposite directions add up to the same value, turning around takes two turns
+			return (unsigned char)from + (unsigned char)to == 5 ? 2 : 1;
+		}
+
+		/// <summary>
+		/// Gets the direction turned by a number of the smallest turns.
+		/// </summary>
+		/// <param name="direction">The direction before turning.</param>
+		/// <param name="turns">The number of turns, counterclockwise if positive and clockwise if negative.</param>
+		/// <returns>The direction after turning.</returns>
+		static Direction GetRotated(Direction direction, int turns)
+		{
+			int angle = ((int)GetAngle(direction) + turns) % (int)Directions;
+			if (angle < 0)
+				angle += Directions;
+
+			for (unsigned int i = 0; i < Directions; i++)
+			{
+				if ((int)GetAngle(GetDirection(i)) == angle)
+					return GetDirection(i);
+			}
+
+			// Code should never be able to get here
+			return Direction::Invalid;
+		}
+
+		/// <summary>
+		/// Gets the number of moves between two points if there were no walls.
+		/// </summary>
+		/// <param name="first">The first point.</param>
+		/// <param name="second">The second point.</param>
+		/// <returns>The distance.</returns>
+		static unsigned int GetDistance(int first, int second)
+		{
+			int x = first % Width - second % Width;
+			int y = first / Width - second / Width;
+
+			return (x < 0 ? -x : x) + (y < 0 ? -y : y);
+		}
+
+	private:
+		static unsigned int GetAngle(Direction direction)
+		{
+			// Quarters of a full turn
+			switch (direction)
+			{
+			case Direction::Right:
+				return 0;
+			case Direction::Up:
+				return 1;
+			case Direction::Left:
+				return 2;
+			case Direction::Down:
+				return 3;
+			default:
+				return 0;
+			}
+		}
+
+	};
+
+	// The grid where every point has 8 adjacent points, the diagonal ones included
+	template<unsigned int Width, unsigned int Height>
+	class OctileTopology
+	{
+
+	public:
+		// The number of adjacent points
+		static const unsigned int Directions = 8;
+
+		// Every edge is stored by the lower of its points, which has half of the directions towards the higher ones
+		static const unsigned int Edges = Width * Height * Directions / 2;
+
+		static Direction GetDirection(unsigned int index)
+		{
+			// Directional preference: towards the exit first
+			switch (index)
+			{
+			case 0:
+				return Direction::UpRight;
+			case 1:
+				return Direction::Right;
+			case 2:
+				return Direction::Up;
+			case 3:
+				return Direction::DownRight;
+			case 4:
+				return Direction::UpLeft;
+			case 5:
+				return Direction::Left;
+			case 6:
+				return Direction::Down;
+			case 7:
+				return Direction::DownLeft;
+			}
+
+			// Code should never be able to get here
+			return Direction::Invalid;
+		}
+
+		static int GetAdjacent(Direction direction, int currentPoint)
+		{
+			int x = currentPoint % Width;
+			int y = currentPoint / Width;
+
+			switch (direction)
+			{
+			case Direction::Up:
+				return GetPoint(x, y + 1);
+			case Direction::Right:
+				return GetPoint(x + 1, y);
+			case Direction::Left:
+				return GetPoint(x - 1, y);
+			case Direction::Down:
+				return GetPoint(x, y - 1);
+			case Direction::UpRight:
+				return GetPoint(x + 1, y + 1);
+			case Direction::UpLeft:
+				return GetPoint(x - 1, y + 1);
+			case Direction::DownRight:
+				return GetPoint(x + 1, y - 1);
+			case Direction::DownLeft:
+				return GetPoint(x - 1, y - 1);
+			default:
+				return -1;
+			}
+		}
+
+		static Direction GetDirection(int point, int currentPoint)
+		{
+			if (point == -1)
+				return Direction::Invalid;
+
+			for (unsigned int i = 0; i < Directions; i++)
+			{
+				if (GetAdjacent(GetDirection(i), currentPoint) == point)
+					return GetDirection(i);
+			}
+
+			return Direction::Invalid;
+		}
+
+		static unsigned int GetEdge(int first, int second)
+		{
+			if (first > second)
+				return GetEdge(second, first);
+
+			// The directions towards the higher points: Right, UpLeft, Up, UpRight
+			if (GetAdjacent(Direction::Right, first) == second)
+				return first * 4;
+
+			return first * 4 + (second - first - Width + 2);
+		}
+
+		static unsigned int GetTurns(Direction from, Direction to)
+		{
+			// Eighths of a full turn
+			unsigned int turns = (GetAngle(to) + 8 - GetAngle(from)) % 8;
+			return turns > 4 ? 8 - turns : turns;
+		}
+
+		static Direction GetRotated(Direction direction, int turns)
+		{
+			int angle = ((int)GetAngle(direction) + turns) % (int)Directions;
+			if (angle < 0)
+				angle += Directions;
+
+			for (unsigned int i = 0; i < Directions; i++)
+			{
+				if ((int)GetAngle(GetDirection(i)) == angle)
+					return GetDirection(i);
+			}
+
+			// Code should never be able to get here
+			return Direction::Invalid;
+		}
+
+		static unsigned int GetDistance(int first, int second)
+		{
+			int x = first % Width - second % Width;
+			int y = first / Width - second / Width;
+
+			x = x < 0 ? -x : x;
+			y = y < 0 ? -y : y;
+
+			return x > y ? x : y;
+		}
+
+	private:
+		static int GetPoint(int x, int y)
+		{
+			if (x < 0 || y < 0 || x >= (int)Width || y >= (int)Height)
+				return -1;
+
+			return y * Width + x;
+		}
+
+		static unsigned int GetAngle(Direction direction)
+		{
+			switch (direction)
+			{
+			case Direction::Right:
+				return 0;
+			case Direction::UpRight:
+				return 1;
+			case Direction::Up:
+				return 2;
+			case Direction::UpLeft:
+				return 3;
+			case Direction::Left:
+				return 4;
+			case Direction::DownLeft:
+				return 5;
+			case Direction::Down:
+				return 6;
+			case Direction::DownRight:
+				return 7;
+			default:
+				return 0;
+			}
+		}
+
+	};
+
+	// The grid of hexagons where every odd row is shifted right by half of a hexagon
+	template<unsigned int Width, unsigned int Height>
+	class HexTopology
+	{
+
+	public:
+		// The number of adjacent points
+		static const unsigned int Directions = 6;
+
+		// Every edge is stored by the lower of its points, which has half of the directions towards the higher ones
+		static const unsigned int Edges = Width * Height * Directions / 2;
+
+		static Direction GetDirection(unsigned int index)
+		{
+			// Directional preference: towards the exit first
+			switch (index)
+			{
+			case 0:
+				return Direction::UpRight;
+			case 1:
+				return Direction::Right;
+			case 2:
+				return Direction::UpLeft;
+			case 3:
+				return Direction::DownRight;
+			case 4:
+				return Direction::Left;
+			case 5:
+				return Direction::DownLeft;
+			}
+
+			// Code should never be able to get here
+			return Direction::Invalid;
+		}
+
+		static int GetAdjacent(Direction direction, int currentPoint)
+		{
+			int x = currentPoint % Width;
+			int y = currentPoint / Width;
+
+			// The diagonal neighbours of an odd row are shifted right
+			int shift = y % 2;
+
+			switch (direction)
+			{
+			case Direction::Right:
+				return GetPoint(x + 1, y);
+			case Direction::Left:
+				return GetPoint(x - 1, y);
+			case Direction::UpRight:
+				return GetPoint(x + shift, y + 1);
+			case Direction::UpLeft:
+				return GetPoint(x + shift - 1, y + 1);
+			case Direction::DownRight:
+				return GetPoint(x + shift, y - 1);
+			case Direction::DownLeft:
+				return GetPoint(x + shift - 1, y - 1);
+			default:
+				return -1;
+			}
+		}
+
+		static Direction GetDirection(int point, int currentPoint)
+		{
+			if (point == -1)
+				return Direction::Invalid;
+
+			for (unsigned int i = 0; i < Directions; i++)
+			{
+				if (GetAdjacent(GetDirection(i), currentPoint) == point)
+					return GetDirection(i);
+			}
+
+			return Direction::Invalid;
+		}
+
+		static unsigned int GetEdge(int first, int second)
+		{
+			if (first > second)
+				return GetEdge(second, first);
+
+			// The directions towards the higher points: Right, UpLeft, UpRight
+			if (GetAdjacent(Direction::Right, first) == second)
+				return first * 3;
+
+			return first * 3 + (GetAdjacent(Direction::UpLeft, first) == second ? 1 : 2);
+		}
+
+		static unsigned int GetTurns(Direction from, Direction to)
+		{
+			// Sixths of a full turn
+			unsigned int turns = (GetAngle(to) + 6 - GetAngle(from)) % 6;
+			return turns > 3 ? 6 - turns : turns;
+		}
+
+		static Direction GetRotated(Direction direction, int turns)
+		{
+			int angle = ((int)GetAngle(direction) + turns) % (int)Directions;
+			if (angle < 0)
+				angle += Directions;
+
+			for (unsigned int i = 0; i < Directions; i++)
+			{
+				if ((int)GetAngle(GetDirection(i)) == angle)
+					return GetDirection(i);
+			}
+
+			// Code should never be able to get here
+			return Direction::Invalid;
+		}
+
+		static unsigned int GetDistance(int first, int second)
+		{
+			// The distance of the cube coordinates of the hexagons
+			int firstColumn = first % Width - (first / Width - first / Width % 2) / 2;
+			int secondColumn = second % Width - (second / Width - second / Width % 2) / 2;
+
+			int q = firstColumn - secondColumn;
+			int r = first / Width - second / Width;
+			int s = q + r;
+
+			return ((q < 0 ? -q : q) + (r < 0 ? -r : r) + (s < 0 ? -s : s)) / 2;
+		}
+
+	private:
+		static int GetPoint(int x, int y)
+		{
+			if (x < 0 || y < 0 || x >= (int)Width || y >= (int)Height)
+				return -1;
+
+			return y * Width + x;
+		}
+
+		static unsigned int GetAngle(Direction direction)
+		{
+			switch (direction)
+			{
+			case Direction::Right:
+				return 0;
+			case Direction::UpRight:
+				return 1;
+			case Direction::UpLeft:
+				return 2;
+			case Direction::Left:
+				return 3;
+			case Direction::DownLeft:
+				return 4;
+			case Direction::DownRight:
+				return 5;
+			default:
+				return 0;
+			}
+		}
+
+	};
+
+	// The topology of the maze is chosen at compile time, so that the searches do not dispatch on it
+#if defined MAZESOLVER_HEX_TOPOLOGY
+	using Topology = HexTopology<MAZESOLVER_WIDTH, MAZESOLVER_HEIGHT>;
+#elif defined MAZESOLVER_OCTILE_TOPOLOGY
+	using Topology = OctileTopology<MAZESOLVER_WIDTH, MAZESOLVER_HEIGHT>;
+#else
+	using Topology = SquareTopology<MAZESOLVER_WIDTH, MAZESOLVER_HEIGHT>;
+#endif
+
+}
\ No newline at end of file
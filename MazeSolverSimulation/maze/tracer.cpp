@@ -0,0 +1,119 @@
+#include "tracer.h"
+
+#if defined MAZESOLVER_TRACING
+
+#include <chrono>
+#include <cstdio>
+
+std::atomic<MazeSolver::Tracer::Buffer*> MazeSolver::Tracer::buffers(nullptr);
+std::atomic<unsigned int> MazeSolver::Tracer::threads(0);
+
+long long MazeSolver::Tracer::Now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void MazeSolver::Tracer::Record(const char* name, long long start, long long end)
+{
+	Buffer* buffer = GetBuffer();
+
+	unsigned int count = buffer->Count.load(std::memory_order_relaxed);
+	if (count == Events)
+	{
+		buffer->Dropped++;
+		return;
+	}
+
+	Event& event = buffer->Events[count];
+	event.Name = name;
+	event.Start = start;
+	event.End = end;
+
+	// The event is complete before the writer can see it
+	buffer->Count.store(count + 1, std::memory_order_release);
+}
+
+bool MazeSolver::Tracer::Write(const char* path)
+{
+	std::FILE* file = std::fopen(path, "w");
+	if (file == nullptr)
+		return false;
+
+	// The first event starts the timeline
+	long long origin = 0;
+	bool first = true;
+	for (Buffer* buffer = buffers.load(std::memory_order_acquire); buffer != nullptr; buffer = buffer->Next)
+	{
+		unsigned int count = buffer->Count.load(std::memory_order_acquire);
+		for (unsigned int i = 0; i < count; i++)
+		{
+			if (first || buffer->Events[i].Start < origin)
+				origin = buffer->Events[i].Start;
+
+			first = false;
+		}
+	}
+
+	std::fprintf(file, "{\"traceEvents\":[\n");
+
+	first = true;
+	for (Buffer* buffer = buffers.load(std::memory_order_acquire); buffer != nullptr; buffer = buffer->Next)
+	{
+		unsigned int count = buffer->Count.load(std::memory_order_acquire);
+		for (unsigned int i = 0; i < count; i++)
+		{
+			Event& event = buffer->Events[i];
+
+			// The complete events are in microseconds
+			std::fprintf(file, "%s{\"name\":\"%s\",\"cat\":\"solver\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+				first ? "" : ",\n", event.Name, (event.Start - origin) / 1000.0, (event.End - event.Start) / 1000.0, buffer->Thread);
+
+			first = false;
+		}
+
+		if (buffer->Dropped != 0)
+		{
+			std::fprintf(file, "%s{\"name\":\"Dropped %u events\",\"ph\":\"i\",\"s\":\"t\",\"ts\":0,\"pid\":1,\"tid\":%u}",
+				first ? "" : ",\n", buffer->Dropped, buffer->Thread);
+
+			first = false;
+		}
+	}
+
+	std::fprintf(file, "\n],\"displayTimeUnit\":\"ms\"}\n");
+
+	return std::fclose(file) == 0;
+}
+
+void MazeSolver::Tracer::Clear()
+{
+	for (Buffer* buffer = buffers.load(std::memory_order_acquire); buffer != nullptr; buffer = buffer->Next)
+	{
+		buffer->Count.store(0, std::memory_order_relaxed);
+		buffer->Dropped = 0;
+	}
+}
+
+MazeSolver::Tracer::Buffer* MazeSolver::Tracer::GetBuffer()
+{
+	thread_local Buffer* buffer = nullptr;
+	if (buffer != nullptr)
+		return buffer;
+
+	buffer = new Buffer();
+	buffer->Count.store(0, std::memory_order_relaxed);
+	buffer->Dropped = 0;
+	buffer->Thread = threads.fetch_add(1, std::memory_order_relaxed) + 1;
+
+	// The buffer is added to the front of the list without locking
+	Buffer* head = buffers.load(std::memory_order_relaxed);
+	do
+	{
+		buffer->Next = head;
+	}
+	while (!buffers.compare_exchange_weak(head, buffer, std::memory_order_release, std::memory_order_relaxed));
+
+	return buffer;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "config.h"
+
+#if defined MAZESOLVER_TRACING
+
+#include <atomic>
+
+namespace MazeSolver
+{
+
+	// Records the time spent in the phases of the solver, every thread records into a buffer of its own,
+	// the timeline is written as trace events that Chrome and Perfetto can show
+	class Tracer
+	{
+
+	public:
+		// The number of events kept for each thread, the later ones are dropped
+		static const unsigned int Events = MAZESOLVER_TRACE_EVENTS;
+
+	public:
+		/// <summary>
+		/// Gets the time of the trace.
+		/// </summary>
+		/// <returns>The time in nanoseconds.</returns>
+		static long long Now();
+
+		/// <summary>
+		/// Records an event of the calling thread.
+		/// </summary>
+		/// <param name="name">The name of the event, it has to live as long as the trace.</param>
+		/// <param name="start">The time the event started.</param>
+		/// <param name="end">The time the event ended.</param>
+		static void Record(const char* name, long long start, long long end);
+
+		/// <summary>
+		/// Writes the events of every thread as a trace-event JSON file,
+		/// the threads should not record meanwhile.
+		/// </summary>
+		/// <param name="path">The path of the file.</param>
+		/// <returns>True if the file is written, false otherwise.</returns>
+		static bool Write(const char* path);
+
+		/// <summary>
+		/// Forgets the recorded events, the threads should not record meanwhile.
+		/// </summary>
+		static void Clear();
+
+	private:
+		struct Event
+		{
+			const char* Name;
+			long long Start;
+			long long End;
+		};
+
+		struct Buffer
+		{
+			Event Events[Tracer::Events];
+
+			// Written only by the thread of the buffer, the events before it are complete
+			std::atomic<unsigned int> Count;
+			unsigned int Dropped;
+
+			unsigned int Thread;
+			Buffer* Next;
+		};
+
+	private:
+		static Buffer* GetBuffer();
+
+	private:
+		// The buffers of every thread that has recorded, they are never freed
+		static std::atomic<Buffer*> buffers;
+		static std::atomic<unsigned int> threads;
+
+	};
+
+	// Records the time from its construction to its destruction
+	class TraceScope
+	{
+
+	public:
+		TraceScope(const char* name)
+			: name(name), start(Tracer::Now()) {}
+
+		~TraceScope()
+		{
+			Tracer::Record(name, start, Tracer::Now());
+		}
+
+	private:
+		const char* name;
+		long long start;
+
+	};
+
+}
+
+#define MAZESOLVER_TRACE_JOIN(first, second) first##second
+#define MAZESOLVER_TRACE_NAME(line) MAZESOLVER_TRACE_JOIN(traceScope, line)
+
+// Traces the rest of the enclosing block
+#define MAZESOLVER_TRACE_SCOPE(name) MazeSolver::TraceScope MAZESOLVER_TRACE_NAME(__LINE__)(name)
+
+#else
+
+// The tracing compiles to nothing
+#define MAZESOLVER_TRACE_SCOPE(name)
+
+#endif
\ No newline at end of file
@@ -0,0 +1,34 @@
+#include "mazesolver.h"
+
+bool MazeSolver::Solver::WallFollowerSolution()
+{
+	// The wall follower is shared with the standalone follower, the solver remembers the edges it scanned
+	SolveStatus status = WallFollower<Solver>::Solve(*this);
+
+	// A stopped solve has its status set already
+	if (status == SolveStatus::GaveUp)
+		result.Status = status;
+
+	return status == SolveStatus::Solved;
+}
+
+bool MazeSolver::Solver::FindAccessible(const int* points, unsigned int count, unsigned int& index)
+{
+	for (index = 0; index < count; index++)
+	{
+		int point = points[index];
+		if (IsOpen(point, CurrentPoint))
+			return true;
+
+		if (IsClosed(point, CurrentPoint))
+			continue;
+
+		if (!CanScan())
+			return false;
+
+		if (IsAccessible(point))
+			return true;
+	}
+
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,313 @@
+#pragma once
+
+#include "config.h"
+
+#include "solveresult.h"
+#include "topology.h"
+
+namespace MazeSolver
+{
+
+	// The wall follower of the solver and of the standalone follower. The runner moves and keeps the marks,
+	// the wall follower keeps only a few variables of its own. A runner has:
+	// - int CurrentPoint, int EndPoint and Direction heading, the direction of its last move
+	// - bool FindAccessible(const int* points, unsigned int count, unsigned int& index),
+	//   the index is the count if none of the points is accessible and false is returned if the runner is stopped
+	// - bool CanMove(), false if the runner is stopped
+	// - void Move(int point)
+	// - unsigned int GetMarks(int point, int currentPoint), void Mark(int point, int currentPoint) and void ClearMarks(),
+	//   only without MAZESOLVER_NO_TREMAUX_MARKS
+	template<typename Runner>
+	class WallFollower
+	{
+
+	public:
+		/// <summary>
+		/// Heads for the exit and follows the walls that block it with the Pledge count of the turns.
+		/// If the walls lead the runner around in a loop, it explores with the Tremaux marks on the edges.
+		/// </summary>
+		/// <param name="runner">The runner.</param>
+		/// <returns>Solved, Unreachable if there are no paths to the exit or the runner is stopped,
+		/// or GaveUp if the runner loops without the marks.</returns>
+		static SolveStatus Solve(Runner& runner)
+		{
+			/*
+				let I be a runner
+				let h be the heading of I
+				let c be the count of the turns
+				let H be the point where I hit a wall
+
+				repeat
+					if I reached the exit
+						end
+
+					if I is not following a wall or I is closer to the exit than H and c is 0
+						w = the first accessible point closer to the exit, the closest and the straightest first
+						if w is found
+							I stops following the wall
+							I.Go(w)
+							continue
+
+					if I is not following a wall
+						H = I.CurrentPoint
+						c = 0
+						h = the direction to the exit that is blocked
+						I starts following the wall with it on the right
+
+					w = the first accessible point turning from the right of h to the left
+					c += the turns from h to w
+					I.Go(w)
+
+					if I has been at the same point with the same heading since H
+						I explores with the Tremaux marks
+						end
+			*/
+
+			// The whole state of the runner, none of it grows with the maze
+			bool following = false;
+			Direction facing = runner.heading;
+			int turns = 0;
+			unsigned int hitDistance = 0;
+
+			// Brent's cycle detection on the point and the heading of the runner while it follows a wall
+			int loopPoint = -1;
+			Direction loopFacing = Direction::Invalid;
+			unsigned int loopPower = 1;
+			unsigned int loopLength = 0;
+
+			int points[Topology::Directions];
+			int pointTurns[Topology::Directions];
+			unsigned int index;
+
+			while (true)
+			{
+				if (runner.CurrentPoint == runner.EndPoint) // Reached the end
+					return SolveStatus::Solved;
+
+				unsigned int distance = Topology::GetDistance(runner.CurrentPoint, runner.EndPoint);
+
+				// Like in the Pledge algorithm, the wall is left only with its turns undone,
+				// and only closer to the exit than where it was hit, so that the runner never comes back to the same wall
+				if (!following || (distance < hitDistance && turns == 0))
+				{
+					// The points closer to the exit, the closest ones and then the ones with the fewest turns first
+					unsigned int count = 0;
+					for (unsigned int i = 0; i < Topology::Directions; i++)
+					{
+						int adjacent = Topology::GetAdjacent(Topology::GetDirection(i), runner.CurrentPoint);
+						if (adjacent == -1)
+							continue;
+
+						unsigned int adjacentDistance = Topology::GetDistance(adjacent, runner.EndPoint);
+						if (adjacentDistance >= distance)
+							continue;
+
+						int adjacentTurns = runner.heading == Direction::Invalid ? 0 :
+							(int)Topology::GetTurns(runner.heading, Topology::GetDirection(adjacent, runner.CurrentPoint));
+
+						unsigned int position = count++;
+						while (position > 0)
+						{
+							int other = points[position - 1];
+							unsigned int otherDistance = Topology::GetDistance(other, runner.EndPoint);
+							if (otherDistance < adjacentDistance || (otherDistance == adjacentDistance && pointTurns[position - 1] <= adjacentTurns))
+								break;
+
+							points[position] = other;
+							pointTurns[position] = pointTurns[position - 1];
+							position--;
+						}
+
+						points[position] = adjacent;
+						pointTurns[position] = adjacentTurns;
+					}
+
+					if (!runner.FindAccessible(points, count, index))
+						return SolveStatus::Unreachable;
+
+					if (index < count)
+					{
+						if (!runner.CanMove())
+							return SolveStatus::Unreachable;
+
+						following = false;
+						runner.Move(points[index]);
+						continue;
+					}
+
+					if (!following)
+					{
+						// The wall is kept on the right, so the runner turns left along it
+						following = true;
+						facing = Topology::GetDirection(points[0], runner.CurrentPoint);
+						turns = 0;
+						hitDistance = distance;
+
+						loopPoint = -1;
+						loopPower = 1;
+						loopLength = 0;
+					}
+				}
+
+				// Counterclockwise from the right of the heading, turning back is the last resort.
+				// At the hit point the heading faces the wall, so the runner starts from the left of it
+				bool hit = loopPoint == -1;
+				int firstTurn = hit ? 1 : -(int)(Topology::Directions / 2 - 1);
+
+				unsigned int count = 0;
+				for (int turn = firstTurn; turn < firstTurn + (int)Topology::Directions - (hit ? 1 : 0); turn++)
+				{
+					int adjacent = Topology::GetAdjacent(Topology::GetRotated(facing, turn), runner.CurrentPoint);
+					if (adjacent == -1)
+						continue;
+
+					// The turns are counted the shorter way round
+					points[count] = adjacent;
+					pointTurns[count] = turn > (int)(Topology::Directions / 2) ? turn - (int)Topology::Directions : turn;
+					count++;
+				}
+
+				if (!runner.FindAccessible(points, count, index))
+					return SolveStatus::Unreachable;
+
+				// The runner is walled in
+				if (index == count)
+					return SolveStatus::Unreachable;
+
+				if (!runner.CanMove())
+					return SolveStatus::Unreachable;
+
+				turns += pointTurns[index];
+				facing = Topology::GetDirection(points[index], runner.CurrentPoint);
+				runner.Move(points[index]);
+
+				// The move from the hit point turns differently than the rest, so the cycle is looked for after it
+				if (hit)
+				{
+					loopPoint = runner.CurrentPoint;
+					loopFacing = facing;
+					continue;
+				}
+
+				if (runner.CurrentPoint == loopPoint && facing == loopFacing)
+				{
+#if !defined MAZESOLVER_NO_TREMAUX_MARKS
+					return TremauxExploration(runner);
+#else
+					return SolveStatus::GaveUp;
+#endif
+				}
+
+				if (++loopLength == loopPower)
+				{
+					loopPoint = runner.CurrentPoint;
+					loopFacing = facing;
+					loopPower *= 2;
+					loopLength = 0;
+				}
+			}
+		}
+
+	private:
+#if !defined MAZESOLVER_NO_TREMAUX_MARKS
+		/// <summary>
+		/// Explores from the current point with the Tremaux marks: an edge is never gone along more than twice,
+		/// and a point reached again along a new edge is turned back from.
+		/// </summary>
+		/// <param name="runner">The runner.</param>
+		/// <returns>Solved, or Unreachable if there are no paths to the exit or the runner is stopped.</returns>
+		static SolveStatus TremauxExploration(Runner& runner)
+		{
+			/*
+				let I be a runner
+				let M be a maze
+				let p be the point I came from
+
+				repeat
+					if I reached the exit
+						end
+
+					if an edge of I.CurrentPoint other than the one from p is marked and the one from p is marked once
+						w = p
+					else
+						w = the accessible point with the fewest marks on the edge to it, closer to the exit first
+						if the edge to w is marked twice
+							end
+					mark the edge to w
+					p = I.CurrentPoint
+					I.Go(w)
+			*/
+
+			runner.ClearMarks();
+
+			int previousPoint = -1;
+
+			int points[Topology::Directions];
+			unsigned int index;
+
+			while (true)
+			{
+				if (runner.CurrentPoint == runner.EndPoint) // Reached the end
+					return SolveStatus::Solved;
+
+				int next = -1;
+
+				// A point reached again along a new edge closes a loop, the runner turns back
+				if (previousPoint != -1 && runner.GetMarks(previousPoint, runner.CurrentPoint) == 1)
+				{
+					for (unsigned int i = 0; i < Topology::Directions; i++)
+					{
+						int adjacent = Topology::GetAdjacent(Topology::GetDirection(i), runner.CurrentPoint);
+						if (adjacent != -1 && adjacent != previousPoint && runner.GetMarks(adjacent, runner.CurrentPoint) > 0)
+						{
+							next = previousPoint;
+							break;
+						}
+					}
+				}
+
+				// The edges not gone along yet and then the one gone along once, which leads back
+				for (unsigned int marks = 0; next == -1 && marks < 2; marks++)
+				{
+					unsigned int count = 0;
+					for (unsigned int i = 0; i < Topology::Directions; i++)
+					{
+						int adjacent = Topology::GetAdjacent(Topology::GetDirection(i), runner.CurrentPoint);
+						if (adjacent == -1 || runner.GetMarks(adjacent, runner.CurrentPoint) != marks)
+							continue;
+
+						// Closer to the exit first
+						unsigned int position = count++;
+						while (position > 0 && Topology::GetDistance(points[position - 1], runner.EndPoint) > Topology::GetDistance(adjacent, runner.EndPoint))
+						{
+							points[position] = points[position - 1];
+							position--;
+						}
+
+						points[position] = adjacent;
+					}
+
+					if (!runner.FindAccessible(points, count, index))
+						return SolveStatus::Unreachable;
+
+					if (index < count)
+						next = points[index];
+				}
+
+				// Every edge the runner can get to is marked twice
+				if (next == -1)
+					return SolveStatus::Unreachable;
+
+				if (!runner.CanMove())
+					return SolveStatus::Unreachable;
+
+				runner.Mark(next, runner.CurrentPoint);
+				previousPoint = runner.CurrentPoint;
+				runner.Move(next);
+			}
+		}
+#endif
+
+	};
+
+}
\ No newline at end of file
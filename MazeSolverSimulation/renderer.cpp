@@ -0,0 +1,159 @@
+#include "renderer.h"
+
+#include "maze/topology.h"
+
+#include <cstdio>
+
+#if defined _WIN32
+#define NOMINMAX
+#include <Windows.h>
+#endif
+
+const char Renderer::Empty;
+const char Renderer::Current;
+
+Renderer::Renderer(int width, int height, double framesPerSecond)
+	: width(width), height(height), walls(MazeSolver::Topology::Edges), cells(width * height, Empty), shownCells(width * height, 0)
+{
+	if (framesPerSecond > 0)
+		frameTime = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1 / framesPerSecond));
+	else
+		frameTime = Clock::duration::zero();
+
+#if defined _WIN32
+	// The console of Windows understands the escape codes only when asked to
+	HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+
+	DWORD mode = 0;
+	GetConsoleMode(console, &mode);
+	SetConsoleMode(console, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+#endif
+}
+
+void Renderer::AddWall(int first, int second)
+{
+	walls[MazeSolver::Topology::GetEdge(first, second)] = true;
+}
+
+bool Renderer::HasWall(int first, int second)
+{
+	return walls[MazeSolver::Topology::GetEdge(first, second)];
+}
+
+void Renderer::Draw(int point)
+{
+	cells[currentPoint] = Empty;
+	cells[point] = Current;
+	currentPoint = point;
+
+	// Clear the screen and start at its top
+	frame = "\x1b[2J\x1b[H";
+
+	frame += std::string(2 * width + 1, '-') + "\n";
+	for (int i = height - 1; i >= 0; i--)
+	{
+		frame += "|";
+		for (int j = 0; j < width; j++)
+		{
+			int drawPoint = i * width + j;
+			frame += cells[drawPoint];
+
+			if (j != width - 1)
+				frame += HasWall(drawPoint, drawPoint + 1) ? "|" : " ";
+		}
+		frame += "|\n";
+
+		if (i != 0)
+		{
+			frame += "|";
+			for (int j = 0; j < width; j++)
+			{
+				// Only the walls to the right and below are drawn, the diagonal ones of the other topologies are not
+				frame += HasWall((i - 1) * width + j, i * width + j) ? "-" : " ";
+
+				if (j != width - 1)
+					frame += " ";
+			}
+			frame += "|\n";
+		}
+	}
+	frame += std::string(2 * width + 1, '-') + "\n";
+
+	shownCells = cells;
+	changedPoints.clear();
+
+	std::fwrite(frame.data(), 1, frame.size(), stdout);
+	std::fflush(stdout);
+
+	lastFrame = Clock::now();
+}
+
+void Renderer::Move(int point)
+{
+	SetCell(currentPoint, Empty);
+	SetCell(point, Current);
+	currentPoint = point;
+
+	// The solver is not slowed down by drawing more often than the frame rate
+	if (Clock::now() - lastFrame >= frameTime)
+		Flush();
+}
+
+void Renderer::Highlight(int point)
+{
+	SetCell(point, Current);
+}
+
+void Renderer::Finish()
+{
+	Flush();
+
+	// The cursor is left under the maze
+	frame.clear();
+	MoveCursor(2 * height + 2, 1);
+
+	std::fwrite(frame.data(), 1, frame.size(), stdout);
+	std::fflush(stdout);
+}
+
+void Renderer::SetCell(int point, char cell)
+{
+	if (cells[point] == cell)
+		return;
+
+	// A point is listed once until it's drawn
+	if (cells[point] == shownCells[point])
+		changedPoints.push_back(point);
+
+	cells[point] = cell;
+}
+
+void Renderer::Flush()
+{
+	frame.clear();
+	for (int point : changedPoints)
+	{
+		if (cells[point] == shownCells[point])
+			continue;
+
+		// The first row of the screen is the upper border
+		MoveCursor(2 * (height - 1 - point / width) + 2, 2 * (point % width) + 2);
+		frame += cells[point];
+
+		shownCells[point] = cells[point];
+	}
+	changedPoints.clear();
+
+	if (!frame.empty())
+	{
+		std::fwrite(frame.data(), 1, frame.size(), stdout);
+		std::fflush(stdout);
+	}
+
+	lastFrame = Clock::now();
+}
+
+void Renderer::MoveCursor(int row, int column)
+{
+	frame += "\x1b[" + std::to_string(row) + ";" + std::to_string(column) + "H";
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+// Draws the maze with ANSI escape codes, after the first frame only the points that changed are redrawn
+class Renderer
+{
+
+public:
+	/// <summary>
+	/// Constructor.
+	/// </summary>
+	/// <param name="width">The width of the maze.</param>
+	/// <param name="height">The height of the maze.</param>
+	/// <param name="framesPerSecond">The most frames drawn in a second, 0 if not limited.</param>
+	Renderer(int width, int height, double framesPerSecond);
+
+	/// <summary>
+	/// Adds a wall between two adjacent points.
+	/// </summary>
+	/// <param name="first">The first point.</param>
+	/// <param name="second">The second point.</param>
+	void AddWall(int first, int second);
+
+	/// <summary>
+	/// Checks whether there is a wall between two adjacent points.
+	/// </summary>
+	/// <param name="first">The first point.</param>
+	/// <param name="second">The second point.</param>
+	/// <returns>True if there is a wall, false otherwise.</returns>
+	bool HasWall(int first, int second);
+
+	/// <summary>
+	/// Clears the screen and draws the whole maze.
+	/// </summary>
+	/// <param name="point">The current point.</param>
+	void Draw(int point);
+
+	/// <summary>
+	/// Moves the current point, the screen is updated once the next frame is due.
+	/// </summary>
+	/// <param name="point">The new current point.</param>
+	void Move(int point);
+
+	/// <summary>
+	/// Highlights a point, like the points of a path.
+	/// </summary>
+	/// <param name="point">The point to highlight.</param>
+	void Highlight(int point);
+
+	/// <summary>
+	/// Draws the pending changes and moves the cursor below the maze.
+	/// </summary>
+	void Finish();
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	static const char Empty = '*';
+	static const char Current = 'O';
+
+private:
+	void SetCell(int point, char cell);
+	void Flush();
+	void MoveCursor(int row, int column);
+
+private:
+	int width;
+	int height;
+
+	// The walls of the maze, one per edge of the topology
+	std::vector<bool> walls;
+
+	// The characters of the points and the ones on the screen
+	std::vector<char> cells;
+	std::vector<char> shownCells;
+	std::vector<int> changedPoints;
+
+	int currentPoint = 0;
+
+	Clock::duration frameTime;
+	Clock::time_point lastFrame;
+
+	// A frame is written at once
+	std::string frame;
+
+};
\ No newline at end of file
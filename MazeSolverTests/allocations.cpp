@@ -0,0 +1,139 @@
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+
+#include "../MazeSolverSimulation/maze/mazesolver.h"
+#include "simulatedmaze.h"
+#include "tests.h"
+
+#if !defined MAZESOLVER_STATIC_CONTAINERS
+#error The containers grow on the heap, define MAZESOLVER_STATIC_CONTAINERS to test that solving does not allocate
+#endif
+
+#if defined __GNUC__ && !defined __clang__ && __GNUC__ >= 11
+// The replaced operators pair malloc with free, GCC only sees the default operators behind the inlined ones
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+// The allocations are counted only while a solve runs
+static bool counting = false;
+static unsigned long long allocations = 0;
+
+void* operator new(std::size_t size)
+{
+	if (counting)
+		allocations++;
+
+	void* memory = std::malloc(size != 0 ? size : 1);
+	if (memory == nullptr)
+		throw std::bad_alloc();
+
+	return memory;
+}
+
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
+
+static SimulatedMaze maze;
+
+static MazeSolver::Solver* solver = nullptr;
+
+static bool Scan(MazeSolver::Direction direction)
+{
+	int point = solver->CurrentPoint;
+	return !maze.IsBlocked(point, maze.GetAdjacent(point, direction));
+}
+
+static void Move(MazeSolver::Direction)
+{
+}
+
+int TestAllocations()
+{
+	// In the order of the solutions
+	const char* const solutions[]
+	{
+		"periodic_correction",
+		"algorithmic_runner",
+		"frontier_exploration",
+		"best_first_runner",
+		"wall_follower"
+	};
+	const int solutionCount = sizeof(solutions) / sizeof(solutions[0]);
+
+	const char* const planners[]
+	{
+		"bfs",
+		"hierarchical",
+		"parallel"
+	};
+
+	const unsigned int mazes = 50;
+
+	int failures = 0;
+	for (int planner = 0; planner < 3; planner++)
+	{
+		for (int solution = 0; solution < solutionCount; solution++)
+		{
+			solver = new MazeSolver::Solver(Scan, Move);
+			solver->SetPlanner((MazeSolver::Planner)planner);
+
+			// The parallel planner starts its threads in the first search, so the first solve is not counted
+			maze.Generate(0, 0);
+			solver->Solve((MazeSolver::Solution)solution);
+
+			allocations = 0;
+			for (int density : { 0, 20, 40 })
+			{
+				for (unsigned int seed = 0; seed < mazes; seed++)
+				{
+					maze.Generate(seed, density);
+					solver->CurrentPoint = solver->StartPoint;
+
+					counting = true;
+					solver->Solve((MazeSolver::Solution)solution);
+					counting = false;
+				}
+			}
+
+			std::string name = std::string("allocations/") + solutions[solution] + "/" + planners[planner];
+			if (allocations != 0)
+			{
+				std::cerr << name << ": " << allocations << " allocation(s) during the solves" << std::endl;
+				failures++;
+			}
+			else
+			{
+				std::cerr << name << ": ok" << std::endl;
+			}
+
+			delete solver;
+			solver = nullptr;
+		}
+	}
+
+	return failures;
+}
\ No newline at end of file
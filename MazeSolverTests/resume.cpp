@@ -0,0 +1,256 @@
+#include <iostream>
+#include <string>
+
+#include "../MazeSolverSimulation/maze/mazesolver.h"
+#include "simulatedmaze.h"
+#include "tests.h"
+
+static SimulatedMaze maze;
+
+static MazeSolver::Solver* solver = nullptr;
+
+// The runner is tracked apart from the solver, so that the resumed solve starts where the runner stopped
+static int runnerPoint = 0;
+static unsigned int moves = 0;
+static bool illegalMove = false;
+
+// The solve is stopped after a number of scans and moves, the state is saved after every move
+static unsigned int actions = 0;
+static unsigned int stopAction = 0;
+static unsigned char state[MazeSolver::Solver::StateSize];
+static unsigned int stateSize = 0;
+static int savedPoint = 0;
+
+static bool IsStopped()
+{
+	return stopAction != 0 && actions >= stopAction;
+}
+
+static int GetAdjacent(int point, MazeSolver::Direction direction)
+{
+	int x = point % SimulatedMaze::Width;
+	int y = point / SimulatedMaze::Width;
+
+	switch (direction)
+	{
+	case MazeSolver::Direction::Up:
+		return y + 1 < SimulatedMaze::Height ? point + SimulatedMaze::Width : -1;
+	case MazeSolver::Direction::Right:
+		return x + 1 < SimulatedMaze::Width ? point + 1 : -1;
+	case MazeSolver::Direction::Left:
+		return x > 0 ? point - 1 : -1;
+	case MazeSolver::Direction::Down:
+		return y > 0 ? point - SimulatedMaze::Width : -1;
+	default:
+		return -1;
+	}
+}
+
+static bool Scan(MazeSolver::Direction direction)
+{
+	if (IsStopped())
+		return false;
+
+	actions++;
+
+	int adjacent = GetAdjacent(runnerPoint, direction);
+	return adjacent != -1 && !maze.IsBlocked(runnerPoint, adjacent);
+}
+
+static void Move(MazeSolver::Direction direction)
+{
+	if (IsStopped())
+		return;
+
+	actions++;
+
+	int adjacent = GetAdjacent(runnerPoint, direction);
+	if (adjacent == -1 || maze.IsBlocked(runnerPoint, adjacent))
+	{
+		illegalMove = true;
+		return;
+	}
+
+	runnerPoint = adjacent;
+	moves++;
+
+	stateSize = solver->SaveState(state, sizeof(state));
+	savedPoint = runnerPoint;
+}
+
+static bool Cancel()
+{
+	return IsStopped();
+}
+
+static bool IsReachable()
+{
+	bool reached[SimulatedMaze::Width * SimulatedMaze::Height] = {};
+	int queue[SimulatedMaze::Width * SimulatedMaze::Height];
+	int first = 0;
+	int last = 0;
+
+	queue[last++] = 0;
+	reached[0] = true;
+
+	while (first < last)
+	{
+		int point = queue[first++];
+		for (MazeSolver::Direction direction : { MazeSolver::Direction::Up, MazeSolver::Direction::Right, MazeSolver::Direction::Left, MazeSolver::Direction::Down })
+		{
+			int adjacent = GetAdjacent(point, direction);
+			if (adjacent == -1 || reached[adjacent] || maze.IsBlocked(point, adjacent))
+				continue;
+
+			reached[adjacent] = true;
+			queue[last++] = adjacent;
+		}
+	}
+
+	return reached[SimulatedMaze::Width * SimulatedMaze::Height - 1];
+}
+
+static MazeSolver::Solver* CreateSolver(MazeSolver::Planner planner)
+{
+	MazeSolver::Solver* created = new MazeSolver::Solver(Scan, Move);
+	created->SetPlanner(planner);
+
+	MazeSolver::Limits limits;
+	limits.Cancel = Cancel;
+	created->SetLimits(limits);
+
+	return created;
+}
+
+static void Reset(int point)
+{
+	runnerPoint = point;
+	moves = 0;
+	illegalMove = false;
+	actions = 0;
+	stopAction = 0;
+	stateSize = 0;
+}
+
+int TestResume()
+{
+	// In the order of the solutions
+	const char* const solutions[]
+	{
+		"periodic_correction",
+		"algorithmic_runner",
+		"frontier_exploration",
+		"best_first_runner",
+		"wall_follower"
+	};
+	const int solutionCount = sizeof(solutions) / sizeof(solutions[0]);
+
+	const char* const planners[]
+	{
+		"bfs",
+		"hierarchical",
+		"parallel"
+	};
+
+	const unsigned int mazes = 20;
+
+	int failures = 0;
+	for (int planner = 0; planner < 3; planner++)
+	{
+		for (int solution = 0; solution < solutionCount; solution++)
+		{
+			std::string name = std::string("resume/") + solutions[solution] + "/" + planners[planner];
+			std::string failure;
+
+			for (int density : { 0, 20, 40 })
+			{
+				for (unsigned int seed = 0; seed < mazes && failure.empty(); seed++)
+				{
+					maze.Generate(seed, density);
+					bool reachable = IsReachable();
+
+					// Stopped part of the way and resumed by a new solver where the runner stopped
+					Reset(0);
+					stopAction = 1 + seed % 40;
+
+					solver = CreateSolver((MazeSolver::Planner)planner);
+					MazeSolver::SolveResult result = solver->Solve((MazeSolver::Solution)solution);
+
+					// The solve may end by itself with the last action before the stop
+					if (result.Status == MazeSolver::SolveStatus::Cancelled)
+					{
+						delete solver;
+						solver = CreateSolver((MazeSolver::Planner)planner);
+						stopAction = 0;
+
+						// Stopped before the first move, the solve starts again
+						if (stateSize == 0)
+						{
+							runnerPoint = solver->StartPoint;
+							result = solver->Solve((MazeSolver::Solution)solution);
+						}
+						else
+						{
+							runnerPoint = savedPoint;
+							if (!solver->LoadState(state, stateSize))
+								failure = "the saved state is not loaded";
+							else
+								result = solver->Resume();
+						}
+					}
+
+					if (illegalMove)
+						failure = "the runner moved through a wall";
+					else if ((bool)result != reachable)
+						failure = reachable ? "the reachable exit is not reached" : "the unreachable exit is reached";
+					else if (result && runnerPoint != solver->EndPoint)
+						failure = "the runner is not at the exit";
+
+					delete solver;
+					solver = nullptr;
+
+					if (!reachable || !failure.empty())
+						continue;
+
+					// Resumed from the state saved by the last move, at the exit
+					Reset(0);
+
+					solver = CreateSolver((MazeSolver::Planner)planner);
+					solver->Solve((MazeSolver::Solution)solution);
+					delete solver;
+
+					solver = CreateSolver((MazeSolver::Planner)planner);
+					runnerPoint = savedPoint;
+					moves = 0;
+
+					if (stateSize == 0 || !solver->LoadState(state, stateSize))
+						failure = "the state saved at the exit is not loaded";
+					else if (!solver->Resume() || moves != 0)
+						failure = "the solve resumed at the exit is not solved without moves";
+
+					// Started at the exit
+					Reset(solver->EndPoint);
+					solver->CurrentPoint = solver->EndPoint;
+
+					if (failure.empty() && (!solver->Solve((MazeSolver::Solution)solution) || moves != 0))
+						failure = "the solve started at the exit is not solved without moves";
+
+					delete solver;
+					solver = nullptr;
+				}
+			}
+
+			if (!failure.empty())
+			{
+				std::cerr << name << ": " << failure << std::endl;
+				failures++;
+			}
+			else
+			{
+				std::cerr << name << ": ok" << std::endl;
+			}
+		}
+	}
+
+	return failures;
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <utility>
+
+#include "../MazeSolverSimulation/maze/mazesolver.h"
+
+// A random maze of the size of the solver for the tests and the benchmarks, the same on every platform for a seed
+class SimulatedMaze
+{
+
+public:
+	static const int Width = MazeSolver::Solver::Width;
+	static const int Height = MazeSolver::Solver::Height;
+
+	// Each point stores the walls on its upper and right edges
+	bool WallUp[Width * Height];
+	bool WallRight[Width * Height];
+
+	/// <summary>
+	/// Generates the walls of the maze.
+	/// </summary>
+	/// <param name="seed">The seed of the maze.</param>
+	/// <param name="density">The chance of a wall on every edge in percent.</param>
+	void Generate(unsigned int seed, int density)
+	{
+		randomState = 0x9E3779B97F4A7C15ULL ^ seed;
+
+		for (int point = 0; point < Width * Height; point++)
+		{
+			WallUp[point] = point + Width < Width * Height && (int)(Random() % 100) < density;
+			WallRight[point] = (point + 1) % Width != 0 && (int)(Random() % 100) < density;
+		}
+	}
+
+	/// <summary>
+	/// Gets the point next to a point, the point has to be inside the maze.
+	/// </summary>
+	/// <param name="point">The point.</param>
+	/// <param name="direction">The direction of the adjacent point.</param>
+	/// <returns>The adjacent point, -1 for a direction of no square grid.</returns>
+	static int GetAdjacent(int point, MazeSolver::Direction direction)
+	{
+		switch (direction)
+		{
+		case MazeSolver::Direction::Up:
+			return point + Width;
+		case MazeSolver::Direction::Right:
+			return point + 1;
+		case MazeSolver::Direction::Left:
+			return point - 1;
+		case MazeSolver::Direction::Down:
+			return point - Width;
+		default:
+			return -1;
+		}
+	}
+
+	/// <summary>
+	/// Checks whether there is a wall between two adjacent points.
+	/// </summary>
+	/// <param name="first">The first point.</param>
+	/// <param name="second">The second point.</param>
+	/// <returns>True if there is a wall, false otherwise.</returns>
+	bool IsBlocked(int first, int second) const
+	{
+		if (first > second)
+			std::swap(first, second);
+
+		if (second - first == 1)
+			return WallRight[first];
+
+		return WallUp[first];
+	}
+
+private:
+	unsigned int Random()
+	{
+		// xorshift64
+		randomState ^= randomState << 13;
+		randomState ^= randomState >> 7;
+		randomState ^= randomState << 17;
+
+		return (unsigned int)(randomState >> 32);
+	}
+
+private:
+	unsigned long long randomState = 0;
+
+};
\ No newline at end of file
@@ -0,0 +1,23 @@
+#include <iostream>
+
+#include "tests.h"
+
+/*
+	Usage: MazeSolverTests
+
+	Solves simulated mazes with every solution and every planner:
+	- counts the allocations made during the solves, with the containers of a fixed capacity solving never allocates
+	- stops the solves part of the way and at the exit, resumes them from the saved state and checks their results
+	Every failure is reported and the tests exit with a non-zero code.
+*/
+
+int main()
+{
+	int failures = 0;
+	failures += TestAllocations();
+	failures += TestResume();
+
+	std::cerr << failures << " failure(s)" << std::endl;
+
+	return failures == 0 ? 0 : 1;
+}
\ No newline at end of file
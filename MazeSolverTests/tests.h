@@ -0,0 +1,13 @@
+#pragma once
+
+/// <summary>
+/// Solves with every solution and every planner and counts the allocations made during the solves.
+/// </summary>
+/// <returns>The number of failures.</returns>
+int TestAllocations();
+
+/// <summary>
+/// Stops solves part of the way, resumes them from the saved state and compares the results with the ones of the maze.
+/// </summary>
+/// <returns>The number of failures.</returns>
+int TestResume();
\ No newline at end of file